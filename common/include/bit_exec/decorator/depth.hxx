@@ -21,10 +21,16 @@
 #ifndef BIT_EXEC_DECORATOR_DEPTH
 #define BIT_EXEC_DECORATOR_DEPTH
 
+#include <bit_exec/decorator/handle_map.hxx>
 #include <bit_exec/decorator/interface.hxx>
 
+#include <algorithm>
 #include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace cingulata {
 
@@ -37,11 +43,18 @@ template <typename bit_exec_interface_t> class Depth_impl;
 };
 
 /**
- * @brief      Bit executor statistics decorator
- * @details    This class counts the number of times each abstract method of @c
- *             bit_exec_t is called. The actual implementation depends on the
- *             parent class of template parameter. Thus for classes inheriting
- *             from IBitExecSHE only XOR and AND gates will be counted.
+ * @brief      Bit executor depth decorator
+ * @details    This class computes the multiplicative and the overall depth
+ *             of every handle produced by @c bit_exec_t. Depths are reported
+ *             globally, per written output, per named section and along the
+ *             critical path (path of maximal multiplicative depth). Gates
+ *             with a constant result (eg. @c x^x or @c x&~x) have depth 0.
+ *             The actual implementation depends on the parent class of
+ *             template parameter, only classes inheriting from IBitExecSHE
+ *             are supported. Handles are identified by their pointer, a gate
+ *             returning a known handle keeps its depth, thus @c bit_exec_t
+ *             must not reuse pointers of released objects while depths are
+ *             computed (as BitTracker).
  *
  * @tparam     bit_exec_t  Bit executor implementation to log
  * @tparam     <unnamed>   verify if given @c bit_exec_t class inherits from @c
@@ -53,12 +66,32 @@ class Depth : public Depth_impl<typename bit_exec_t::interface_type> {};
 namespace {
 
 template <> class Depth_impl<IBitExecSHE> : public IDecorator {
-  struct DepthVals {
+public:
+  enum class Op : uint8_t { CONST, INPUT, AND, XOR };
+
+  /**
+   * @brief      Executed gate, @c pred is the index of the gate input on
+   *             critical path
+   */
+  struct Gate {
     unsigned mult_depth;
     unsigned depth;
+    uint32_t pred;
+    Op op;
   };
 
-public:
+  /**
+   * @brief      Maximal depths of a written output or of a section
+   */
+  struct Record {
+    std::string name;
+    unsigned mult_depth;
+    unsigned depth;
+    unsigned gate_cnt;
+  };
+
+  static constexpr uint32_t NO_GATE = ~0u;
+
   Depth_impl() { post_reset(); }
 
   void print() {
@@ -69,56 +102,260 @@ public:
   unsigned mult_depth() { return m_mult_depth_max; }
   unsigned depth() { return m_depth_max; }
 
+  /**
+   * @brief      Depths of outputs, in the order of @c write calls
+   */
+  const std::vector<Record> &output_depths() const { return m_outputs; }
+
+  /**
+   * @brief      Depths of closed sections, in closing order
+   */
+  const std::vector<Record> &section_depths() const { return m_sections; }
+
+  /**
+   * @brief      Starts a named section, depths of gates executed until the
+   *             matching @c end_section call are reported under @c name.
+   *             Sections can be nested, a section includes its sub-sections.
+   */
+  void begin_section(const std::string &name) {
+    m_open_sections.push_back({name, 0, 0, 0});
+  }
+
+  void end_section() {
+    if (m_open_sections.empty())
+      return;
+
+    Record sec = std::move(m_open_sections.back());
+    m_open_sections.pop_back();
+    if (not m_open_sections.empty()) {
+      Record &parent = m_open_sections.back();
+      parent.mult_depth = std::max(parent.mult_depth, sec.mult_depth);
+      parent.depth = std::max(parent.depth, sec.depth);
+      parent.gate_cnt += sec.gate_cnt;
+    }
+    m_sections.push_back(std::move(sec));
+  }
+
+  /**
+   * @brief      Gates of the critical path, from a circuit input (or
+   *             constant) to the deepest gate
+   */
+  std::vector<Gate> critical_path() const {
+    std::vector<Gate> path;
+    for (uint32_t g = m_deepest; g != NO_GATE; g = m_gates[g].pred)
+      path.push_back(m_gates[g]);
+    std::reverse(path.begin(), path.end());
+    return path;
+  }
+
+  /**
+   * @brief      Writes depth report in JSON format: global depths, outputs,
+   *             sections and critical path
+   */
+  void export_json(std::ostream &stream) const {
+    static const char *op_str[] = {"CONST", "INPUT", "AND", "XOR"};
+
+    auto records = [&](const char *key, const std::vector<Record> &recs,
+                       const bool with_gates) {
+      stream << "  \"" << key << "\": [";
+      for (size_t i = 0; i < recs.size(); ++i) {
+        stream << (i ? ",\n" : "\n") << "    {\"name\": \""
+               << json_escape(recs[i].name)
+               << "\", \"mult_depth\": " << recs[i].mult_depth
+               << ", \"depth\": " << recs[i].depth;
+        if (with_gates)
+          stream << ", \"gates\": " << recs[i].gate_cnt;
+        stream << "}";
+      }
+      stream << (recs.empty() ? "],\n" : "\n  ],\n");
+    };
+
+    stream << "{\n";
+    stream << "  \"mult_depth\": " << m_mult_depth_max << ",\n";
+    stream << "  \"depth\": " << m_depth_max << ",\n";
+    records("outputs", m_outputs, false);
+    records("sections", m_sections, true);
+
+    std::vector<uint32_t> path;
+    for (uint32_t g = m_deepest; g != NO_GATE; g = m_gates[g].pred)
+      path.push_back(g);
+
+    stream << "  \"critical_path\": [";
+    for (size_t i = path.size(); i-- > 0;) {
+      const Gate &gate = m_gates[path[i]];
+      stream << (i + 1 < path.size() ? ",\n" : "\n") << "    {\"op\": \""
+             << op_str[(uint8_t)gate.op] << "\"";
+      auto it = m_inp_names.find(path[i]);
+      if (it != m_inp_names.end())
+        stream << ", \"name\": \"" << json_escape(it->second) << "\"";
+      stream << ", \"mult_depth\": " << gate.mult_depth
+             << ", \"depth\": " << gate.depth << "}";
+    }
+    stream << (path.empty() ? "]\n" : "\n  ]\n");
+    stream << "}" << std::endl;
+  }
+
+  void export_json(const std::string &file_name) const {
+    std::ofstream file(file_name);
+    if (file.is_open()) {
+      export_json(file);
+    } else {
+      fprintf(stderr, "Error: Unable to open file '%s'\n", file_name.c_str());
+    }
+  }
+
   void post_reset() override {
-    m_depth.clear();
+    m_handles.clear();
+    m_gates.clear();
+    m_folds.clear();
+    m_inp_names.clear();
+    m_outputs.clear();
+    m_sections.clear();
+    m_open_sections.clear();
+    m_deepest = NO_GATE;
     m_mult_depth_max = 0;
     m_depth_max = 0;
   }
 
-  void post_encode(const ObjHandle &res, const bit_plain_t) override {
-    m_depth[res.get<void>()] = {0, 0};
+  void post_encode(const ObjHandle &res, const bit_plain_t pt_val) override {
+    m_handles[res.get<void>()] = add_leaf(Op::CONST, pt_val & 1);
   }
 
   void post_encrypt(const ObjHandle &res, const bit_plain_t) override {
-    m_depth[res.get<void>()] = {0, 0};
+    m_handles[res.get<void>()] = add_leaf(Op::INPUT);
+  }
+
+  void post_read(const ObjHandle &res, const std::string &name) override {
+    const uint32_t g = add_leaf(Op::INPUT);
+    m_inp_names[g] = name;
+    m_handles[res.get<void>()] = g;
   }
 
-  void post_read(const ObjHandle &res, const std::string &) override {
-    m_depth[res.get<void>()] = {0, 0};
+  void post_write(const ObjHandle &in, const std::string &name) override {
+    const Gate &gate = m_gates[m_handles.at(in.get<void>())];
+    m_outputs.push_back({name, gate.mult_depth, gate.depth, 0});
   }
 
   void post_op_and(const ObjHandle &res, const ObjHandle &in1,
                    const ObjHandle &in2) override {
-    const DepthVals &vals_1 = m_depth.at(in1.get<void>());
-    const DepthVals &vals_2 = m_depth.at(in2.get<void>());
-
-    const unsigned mult_depth =
-        std::max(vals_1.mult_depth, vals_2.mult_depth) + 1;
-    const unsigned depth = std::max(vals_1.depth, vals_2.depth) + 1;
-
-    m_depth[res.get<void>()] = {mult_depth, depth};
-    m_mult_depth_max = std::max(m_mult_depth_max, mult_depth);
-    m_depth_max = std::max(m_depth_max, depth);
+    add_gate(Op::AND, res, in1, in2);
   }
 
   void post_op_xor(const ObjHandle &res, const ObjHandle &in1,
                    const ObjHandle &in2) override {
-    const DepthVals &vals_1 = m_depth.at(in1.get<void>());
-    const DepthVals &vals_2 = m_depth.at(in2.get<void>());
+    add_gate(Op::XOR, res, in1, in2);
+  }
 
-    const unsigned mult_depth = std::max(vals_1.mult_depth, vals_2.mult_depth);
-    const unsigned depth = std::max(vals_1.depth, vals_2.depth) + 1;
+protected:
+  uint32_t add_leaf(const Op op, const int8_t val = -1) {
+    m_gates.push_back({0, 0, NO_GATE, op});
+    m_folds.push_back({val, NO_GATE});
+    return m_gates.size() - 1;
+  }
 
-    m_depth[res.get<void>()] = {mult_depth, depth};
+  /**
+   * @brief      Value of gate @c op applied on gates @c g1 and @c g2 if it is
+   *             constant (constant inputs, @c x^x, @c x&~x, ...), -1
+   *             otherwise
+   */
+  int fold(const Op op, const uint32_t g1, const uint32_t g2) const {
+    const int v1 = m_folds[g1].val;
+    const int v2 = m_folds[g2].val;
+    if (v1 >= 0 and v2 >= 0)
+      return op == Op::AND ? (v1 & v2) : (v1 ^ v2);
+    if (op == Op::AND and (v1 == 0 or v2 == 0))
+      return 0;
+    if (g1 == g2)
+      return op == Op::AND ? -1 : 0;
+    if (m_folds[g1].neg == g2)
+      return op == Op::AND ? 0 : 1;
+    return -1;
+  }
+
+  void add_gate(const Op op, const ObjHandle &res, const ObjHandle &in1,
+                const ObjHandle &in2) {
+    /* result is an existing handle, eg. a gate input or @c x for @c ~~x
+     * when @c bit_exec_t simplifies gates (cf. BitTracker) */
+    if (m_handles.find(res.get<void>()) != nullptr)
+      return;
+
+    const uint32_t g1 = m_handles.at(in1.get<void>());
+    const uint32_t g2 = m_handles.at(in2.get<void>());
+
+    /* constant result, folded by executors simplifying gates */
+    const int val = fold(op, g1, g2);
+    if (val >= 0) {
+      m_handles[res.get<void>()] = add_leaf(Op::CONST, val);
+      return;
+    }
+    const Gate &gate_1 = m_gates[g1];
+    const Gate &gate_2 = m_gates[g2];
+
+    /* critical path follows multiplicative depth first */
+    const bool first = std::make_pair(gate_1.mult_depth, gate_1.depth) >=
+                       std::make_pair(gate_2.mult_depth, gate_2.depth);
+    const unsigned mult_depth = std::max(gate_1.mult_depth, gate_2.mult_depth) +
+                                (op == Op::AND ? 1 : 0);
+    const unsigned depth = std::max(gate_1.depth, gate_2.depth) + 1;
+
+    m_gates.push_back({mult_depth, depth, first ? g1 : g2, op});
+    const uint32_t g = m_gates.size() - 1;
+    m_handles[res.get<void>()] = g;
+
+    /* negation, XOR with constant one */
+    m_folds.push_back({-1, NO_GATE});
+    if (op == Op::XOR and (m_folds[g1].val == 1 or m_folds[g2].val == 1)) {
+      const uint32_t inp = m_folds[g1].val == 1 ? g2 : g1;
+      m_folds[g].neg = inp;
+      m_folds[inp].neg = g;
+    }
+
+    if (m_deepest == NO_GATE or
+        std::make_pair(mult_depth, depth) >
+            std::make_pair(m_gates[m_deepest].mult_depth,
+                           m_gates[m_deepest].depth))
+      m_deepest = g;
     m_mult_depth_max = std::max(m_mult_depth_max, mult_depth);
     m_depth_max = std::max(m_depth_max, depth);
+
+    if (not m_open_sections.empty()) {
+      Record &sec = m_open_sections.back();
+      sec.mult_depth = std::max(sec.mult_depth, mult_depth);
+      sec.depth = std::max(sec.depth, depth);
+      sec.gate_cnt++;
+    }
+  }
+
+  static std::string json_escape(const std::string &str) {
+    std::string res;
+    for (const char c : str) {
+      if (c == '"' or c == '\\')
+        res += '\\';
+      res += c;
+    }
+    return res;
   }
 
-protected:
   /**
-   * map from object handle pointer to tuple of multiplicative and overall depth
+   * map from object handle pointer to index of gate producing it
    */
-  std::unordered_map<void *, DepthVals> m_depth;
+  HandleMap<uint32_t> m_handles;
+  std::vector<Gate> m_gates;
+
+  /**
+   * constant value of gates (-1 if not constant) and index of complementary
+   * gate, used to detect constant results
+   */
+  struct Fold {
+    int8_t val;
+    uint32_t neg;
+  };
+  std::vector<Fold> m_folds;
+  std::unordered_map<uint32_t, std::string> m_inp_names;
+  std::vector<Record> m_outputs;
+  std::vector<Record> m_sections;
+  std::vector<Record> m_open_sections;
+  uint32_t m_deepest;
   unsigned m_mult_depth_max;
   unsigned m_depth_max;
 };
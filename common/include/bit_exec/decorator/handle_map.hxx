@@ -0,0 +1,126 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef BIT_EXEC_DECORATOR_HANDLE_MAP
+#define BIT_EXEC_DECORATOR_HANDLE_MAP
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace cingulata {
+namespace decorator {
+
+/**
+ * @brief      Map from object handle pointers to values
+ * @details    Open addressing hash table with linear probing, intended for
+ *             decorators which look up handles on every gate. Entries are
+ *             never removed, a pointer reused by a new object overwrites
+ *             the value of the old one.
+ *
+ * @tparam     V     value type, default constructible
+ */
+template <typename V> class HandleMap {
+public:
+  HandleMap() { clear(); }
+
+  /**
+   * @brief      Value associated to @c key, default value is inserted if
+   *             @c key is missing
+   */
+  V &operator[](const void *key) {
+    if (2 * (m_size + 1) > m_slots.size())
+      rehash(2 * m_slots.size());
+
+    Slot &slot = m_slots[probe(key)];
+    if (slot.first == nullptr) {
+      slot.first = key;
+      m_size++;
+    }
+    return slot.second;
+  }
+
+  /**
+   * @brief      Value associated to @c key, throws @c std::out_of_range if
+   *             @c key is missing
+   */
+  const V &at(const void *key) const {
+    const Slot &slot = m_slots[probe(key)];
+    if (slot.first == nullptr)
+      throw std::out_of_range("HandleMap::at");
+    return slot.second;
+  }
+
+  /**
+   * @brief      Pointer to value associated to @c key, @c nullptr if @c key
+   *             is missing
+   */
+  const V *find(const void *key) const {
+    const Slot &slot = m_slots[probe(key)];
+    return slot.first == nullptr ? nullptr : &slot.second;
+  }
+
+  size_t size() const { return m_size; }
+
+  void clear() {
+    m_slots.assign(MIN_CAPACITY, Slot(nullptr, V()));
+    m_shift = 64 - __builtin_ctzll(MIN_CAPACITY);
+    m_size = 0;
+  }
+
+private:
+  typedef std::pair<const void *, V> Slot;
+  static constexpr size_t MIN_CAPACITY = 64;
+
+  /* index of slot holding @c key, or of empty slot where it goes */
+  size_t probe(const void *key) const {
+    const size_t mask = m_slots.size() - 1;
+    size_t i = hash(key);
+    while (m_slots[i].first != nullptr and m_slots[i].first != key)
+      i = (i + 1) & mask;
+    return i;
+  }
+
+  /* Fibonacci hashing, suited both to aligned and to consecutive keys */
+  size_t hash(const void *key) const {
+    return (reinterpret_cast<uintptr_t>(key) * 0x9E3779B97F4A7C15ULL) >>
+           m_shift;
+  }
+
+  void rehash(const size_t capacity) {
+    std::vector<Slot> old(capacity, Slot(nullptr, V()));
+    old.swap(m_slots);
+    m_shift = 64 - __builtin_ctzll(capacity);
+    for (Slot &slot : old) {
+      if (slot.first != nullptr)
+        m_slots[probe(slot.first)] = std::move(slot);
+    }
+  }
+
+  std::vector<Slot> m_slots;
+  unsigned m_shift;
+  size_t m_size;
+};
+
+} // namespace decorator
+} // namespace cingulata
+
+#endif
@@ -0,0 +1,511 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef BIT_EXEC_DECORATOR_PROFILE
+#define BIT_EXEC_DECORATOR_PROFILE
+
+#include <bit_exec/decorator/interface.hxx>
+#include <bit_exec/obj_man/live_cnt.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cingulata {
+
+class IBitExecFHE;
+class IBitExecSHE;
+
+namespace decorator {
+
+namespace {
+template <typename bit_exec_interface_t> class Profile_impl;
+};
+
+/**
+ * @brief      Bit executor profiling decorator
+ * @details    This class measures the latency of each abstract method of @c
+ *             bit_exec_t and keeps, per method, a logarithmic histogram of
+ *             latencies. Total wall and CPU times, gate throughput and the
+ *             number of live objects (objects allocated by object managers
+ *             while a profiler exists, cf. #obj_man::live_obj_cnt) are
+ *             reported as well. Results can be printed or exported in JSON
+ *             or CSV format.
+ *
+ *             Counters are kept per thread and are updated without locks, a
+ *             lock is taken only the first time a thread executes an
+ *             operation. Latencies of asynchronous executors are
+ *             submission times. As for #Stat, for classes inheriting from
+ *             IBitExecSHE only XOR and AND gates are timed.
+ *
+ * @tparam     bit_exec_t  Bit executor implementation to profile
+ */
+template <typename bit_exec_t>
+class Profile : public Profile_impl<typename bit_exec_t::interface_type> {};
+
+namespace {
+
+class ProfileBase : public IDecorator {
+public:
+  enum class Op : uint8_t {
+    ENCODE, ENCRYPT, DECRYPT, READ, WRITE,
+    NOT, AND, XOR, NAND, ANDYN, ANDNY, OR, NOR, ORYN, ORNY, XNOR, MUX
+  };
+
+  static constexpr unsigned NB_OPS = (unsigned)Op::MUX + 1;
+
+  /**
+   * @brief      Number of histogram buckets, bucket @c i > 0 counts
+   *             latencies in [2^(i-1), 2^i) nanoseconds
+   */
+  static constexpr unsigned NB_BUCKETS = 48;
+
+  /**
+   * @brief      Profile of an operation, merged over all threads
+   */
+  struct OpProfile {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t hist[NB_BUCKETS];
+
+    double mean_ns() const { return count ? (double)total_ns / count : 0; }
+
+    /**
+     * @brief      Estimates quantile @c q from histogram, upper bound of
+     *             the bucket holding it
+     */
+    uint64_t quantile_ns(const double q) const {
+      if (count == 0)
+        return 0;
+      const uint64_t rank = std::max<uint64_t>(1, q * count + 0.5);
+      uint64_t cnt = 0;
+      for (unsigned i = 0; i < NB_BUCKETS; ++i) {
+        cnt += hist[i];
+        if (cnt >= rank)
+          return std::min(std::max(bucket_max(i), min_ns), max_ns);
+      }
+      return max_ns;
+    }
+  };
+
+  ProfileBase() : m_id(next_id()) {
+    obj_man::live_obj_cnt_users().fetch_add(1, std::memory_order_relaxed);
+    post_reset();
+  }
+
+  ~ProfileBase() {
+    obj_man::live_obj_cnt_users().fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  static const char *op_name(const Op op) {
+    static const char *names[] = {
+        "encode", "encrypt", "decrypt", "read", "write", "not",
+        "and",    "xor",     "nand",    "andyn", "andny", "or",
+        "nor",    "oryn",    "orny",    "xnor", "mux"};
+    return names[(unsigned)op];
+  }
+
+  /**
+   * @brief      Profile of operation @c op
+   */
+  OpProfile op_profile(const Op op) const {
+    OpProfile prof = {0, 0, ~0ull, 0, {}};
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &thr : m_threads) {
+      const Counters &cnt = thr->ops[(unsigned)op];
+      prof.count += cnt.count.load(std::memory_order_relaxed);
+      prof.total_ns += cnt.total_ns.load(std::memory_order_relaxed);
+      prof.min_ns = std::min(prof.min_ns, cnt.min_ns.load(std::memory_order_relaxed));
+      prof.max_ns = std::max(prof.max_ns, cnt.max_ns.load(std::memory_order_relaxed));
+      for (unsigned i = 0; i < NB_BUCKETS; ++i)
+        prof.hist[i] += cnt.hist[i].load(std::memory_order_relaxed);
+    }
+    if (prof.count == 0)
+      prof.min_ns = 0;
+    return prof;
+  }
+
+  /**
+   * @brief      Wall clock time since construction or last reset, in seconds
+   */
+  double wall_time() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         m_wall_start)
+        .count();
+  }
+
+  /**
+   * @brief      Process CPU time since construction or last reset, in
+   *             seconds, all threads included
+   */
+  double cpu_time() const {
+    return (double)(std::clock() - m_cpu_start) / CLOCKS_PER_SEC;
+  }
+
+  /**
+   * @brief      Number of executed gates (NOT to MUX operations)
+   */
+  uint64_t gate_cnt() const {
+    uint64_t cnt = 0;
+    for (unsigned op = (unsigned)Op::NOT; op < NB_OPS; ++op)
+      cnt += op_profile((Op)op).count;
+    return cnt;
+  }
+
+  double gates_per_second() const {
+    const double time = wall_time();
+    return time > 0 ? gate_cnt() / time : 0;
+  }
+
+  /**
+   * @brief      Current number of live objects, objects created before the
+   *             first profiler was constructed are not counted
+   */
+  long live_obj_cnt() const {
+    return obj_man::live_obj_cnt().load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief      Maximal number of live objects observed at the end of
+   *             profiled operations
+   */
+  long live_obj_peak() const { return m_live_peak.load(std::memory_order_relaxed); }
+
+  void print() const {
+    printf("Profile (wall %.3f s, cpu %.3f s, %.1f gates/s, live objects %ld, peak %ld):\n",
+           wall_time(), cpu_time(), gates_per_second(), live_obj_cnt(),
+           live_obj_peak());
+    printf(" %-8s  %10s  %12s  %12s  %12s\n", "op", "count", "mean (ns)",
+           "p50 (ns)", "p99 (ns)");
+    for (unsigned op = 0; op < NB_OPS; ++op) {
+      const OpProfile prof = op_profile((Op)op);
+      if (prof.count == 0)
+        continue;
+      printf(" %-8s: %10lu  %12.0f  %12lu  %12lu\n", op_name((Op)op),
+             (unsigned long)prof.count, prof.mean_ns(),
+             (unsigned long)prof.quantile_ns(0.5),
+             (unsigned long)prof.quantile_ns(0.99));
+    }
+  }
+
+  /**
+   * @brief      Writes profile in JSON format: global times, throughput,
+   *             live objects and operation profiles with histograms
+   */
+  void export_json(std::ostream &stream) const {
+    stream << "{\n";
+    stream << "  \"wall_time_s\": " << wall_time() << ",\n";
+    stream << "  \"cpu_time_s\": " << cpu_time() << ",\n";
+    stream << "  \"gates\": " << gate_cnt() << ",\n";
+    stream << "  \"gates_per_second\": " << gates_per_second() << ",\n";
+    stream << "  \"live_objects\": " << live_obj_cnt() << ",\n";
+    stream << "  \"live_objects_peak\": " << live_obj_peak() << ",\n";
+    stream << "  \"hist_buckets\": \"log2_ns\",\n";
+    stream << "  \"ops\": {";
+    bool first = true;
+    for (unsigned op = 0; op < NB_OPS; ++op) {
+      const OpProfile prof = op_profile((Op)op);
+      if (prof.count == 0)
+        continue;
+      stream << (first ? "\n" : ",\n") << "    \"" << op_name((Op)op)
+             << "\": {\"count\": " << prof.count
+             << ", \"total_ns\": " << prof.total_ns
+             << ", \"min_ns\": " << prof.min_ns
+             << ", \"max_ns\": " << prof.max_ns
+             << ", \"mean_ns\": " << prof.mean_ns()
+             << ", \"p50_ns\": " << prof.quantile_ns(0.5)
+             << ", \"p99_ns\": " << prof.quantile_ns(0.99) << ", \"hist\": [";
+      for (unsigned i = 0; i < NB_BUCKETS; ++i)
+        stream << (i ? ", " : "") << prof.hist[i];
+      stream << "]}";
+      first = false;
+    }
+    stream << (first ? "}\n" : "\n  }\n");
+    stream << "}" << std::endl;
+  }
+
+  void export_json(const std::string &file_name) const {
+    std::ofstream file(file_name);
+    if (file.is_open()) {
+      export_json(file);
+    } else {
+      fprintf(stderr, "Error: Unable to open file '%s'\n", file_name.c_str());
+    }
+  }
+
+  /**
+   * @brief      Writes operation profiles in CSV format, one line per
+   *             executed operation, columns @c h0 to @c h47 are histogram
+   *             buckets
+   */
+  void export_csv(std::ostream &stream) const {
+    stream << "op,count,total_ns,min_ns,max_ns,mean_ns,p50_ns,p99_ns";
+    for (unsigned i = 0; i < NB_BUCKETS; ++i)
+      stream << ",h" << i;
+    stream << "\n";
+
+    for (unsigned op = 0; op < NB_OPS; ++op) {
+      const OpProfile prof = op_profile((Op)op);
+      if (prof.count == 0)
+        continue;
+      stream << op_name((Op)op) << "," << prof.count << "," << prof.total_ns
+             << "," << prof.min_ns << "," << prof.max_ns << ","
+             << prof.mean_ns() << "," << prof.quantile_ns(0.5) << ","
+             << prof.quantile_ns(0.99);
+      for (unsigned i = 0; i < NB_BUCKETS; ++i)
+        stream << "," << prof.hist[i];
+      stream << "\n";
+    }
+    stream.flush();
+  }
+
+  void export_csv(const std::string &file_name) const {
+    std::ofstream file(file_name);
+    if (file.is_open()) {
+      export_csv(file);
+    } else {
+      fprintf(stderr, "Error: Unable to open file '%s'\n", file_name.c_str());
+    }
+  }
+
+  /**
+   * @brief      Clears counters, must not be called while operations are in
+   *             progress
+   */
+  void post_reset() override {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (auto &thr : m_threads) {
+        for (Counters &cnt : thr->ops) {
+          cnt.count.store(0, std::memory_order_relaxed);
+          cnt.total_ns.store(0, std::memory_order_relaxed);
+          cnt.min_ns.store(~0ull, std::memory_order_relaxed);
+          cnt.max_ns.store(0, std::memory_order_relaxed);
+          for (auto &bucket : cnt.hist)
+            bucket.store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+    m_live_peak.store(live_obj_cnt(), std::memory_order_relaxed);
+    m_wall_start = std::chrono::steady_clock::now();
+    m_cpu_start = std::clock();
+  }
+
+protected:
+  typedef std::chrono::steady_clock::time_point time_point;
+
+  /**
+   * @brief      Counters of an operation, written by a single thread
+   */
+  struct Counters {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> min_ns{~0ull};
+    std::atomic<uint64_t> max_ns{0};
+    std::atomic<uint64_t> hist[NB_BUCKETS] = {};
+  };
+
+  struct ThreadCounters {
+    std::thread::id thread;
+    Counters ops[NB_OPS];
+    /* start times of operations in progress */
+    std::vector<time_point> starts;
+  };
+
+  void start(const Op) {
+    thread_counters().starts.push_back(std::chrono::steady_clock::now());
+  }
+
+  void stop(const Op op) {
+    const time_point end = std::chrono::steady_clock::now();
+    ThreadCounters &thr = thread_counters();
+    const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            end - thr.starts.back())
+                            .count();
+    thr.starts.pop_back();
+
+    /* single writer, no read-modify-write needed */
+    Counters &cnt = thr.ops[(unsigned)op];
+    auto add = [](std::atomic<uint64_t> &var, const uint64_t val) {
+      var.store(var.load(std::memory_order_relaxed) + val,
+                std::memory_order_relaxed);
+    };
+    add(cnt.count, 1);
+    add(cnt.total_ns, ns);
+    if (ns < cnt.min_ns.load(std::memory_order_relaxed))
+      cnt.min_ns.store(ns, std::memory_order_relaxed);
+    if (ns > cnt.max_ns.load(std::memory_order_relaxed))
+      cnt.max_ns.store(ns, std::memory_order_relaxed);
+    add(cnt.hist[bucket(ns)], 1);
+
+    const long live = live_obj_cnt();
+    long peak = m_live_peak.load(std::memory_order_relaxed);
+    while (live > peak and not m_live_peak.compare_exchange_weak(
+                               peak, live, std::memory_order_relaxed))
+      ;
+  }
+
+  static unsigned bucket(const uint64_t ns) {
+    const unsigned b = ns ? 64 - __builtin_clzll(ns) : 0;
+    return std::min(b, NB_BUCKETS - 1);
+  }
+
+  static uint64_t bucket_max(const unsigned b) { return (1ull << b) - 1; }
+
+  static uint64_t next_id() {
+    static std::atomic<uint64_t> id_cnt(0);
+    return ++id_cnt;
+  }
+
+  /**
+   * @brief      Counters of calling thread, the last used counters are
+   *             cached in a thread local variable
+   */
+  ThreadCounters &thread_counters() {
+    thread_local uint64_t cache_id = 0;
+    thread_local ThreadCounters *cache = nullptr;
+    if (cache_id == m_id)
+      return *cache;
+
+    const std::thread::id thread = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_threads.begin(), m_threads.end(),
+                           [&](const std::unique_ptr<ThreadCounters> &thr) {
+                             return thr->thread == thread;
+                           });
+    if (it == m_threads.end()) {
+      m_threads.emplace_back(new ThreadCounters());
+      m_threads.back()->thread = thread;
+      it = m_threads.end() - 1;
+    }
+    cache_id = m_id;
+    cache = it->get();
+    return *cache;
+  }
+
+  /* unique identifier of decorator, key of thread local cache */
+  const uint64_t m_id;
+  mutable std::mutex m_mutex;
+  std::vector<std::unique_ptr<ThreadCounters>> m_threads;
+  std::atomic<long> m_live_peak;
+  time_point m_wall_start;
+  std::clock_t m_cpu_start;
+};
+
+template <> class Profile_impl<IBitExecFHE> : public ProfileBase {
+public:
+  /* clang-format off */
+  void pre_encode   (const bit_plain_t) override                  { start(Op::ENCODE);  }
+  void pre_encrypt  (const bit_plain_t) override                  { start(Op::ENCRYPT); }
+  void pre_decrypt  (const ObjHandle &) override                  { start(Op::DECRYPT); }
+  void pre_read     (const std::string &) override                { start(Op::READ);    }
+  void pre_write    (const ObjHandle &, const std::string &) override { start(Op::WRITE); }
+
+  void pre_op_not   (const ObjHandle &) override                  { start(Op::NOT);   }
+  void pre_op_and   (const ObjHandle &, const ObjHandle &) override { start(Op::AND);   }
+  void pre_op_xor   (const ObjHandle &, const ObjHandle &) override { start(Op::XOR);   }
+  void pre_op_nand  (const ObjHandle &, const ObjHandle &) override { start(Op::NAND);  }
+  void pre_op_andyn (const ObjHandle &, const ObjHandle &) override { start(Op::ANDYN); }
+  void pre_op_andny (const ObjHandle &, const ObjHandle &) override { start(Op::ANDNY); }
+  void pre_op_or    (const ObjHandle &, const ObjHandle &) override { start(Op::OR);    }
+  void pre_op_nor   (const ObjHandle &, const ObjHandle &) override { start(Op::NOR);   }
+  void pre_op_oryn  (const ObjHandle &, const ObjHandle &) override { start(Op::ORYN);  }
+  void pre_op_orny  (const ObjHandle &, const ObjHandle &) override { start(Op::ORNY);  }
+  void pre_op_xnor  (const ObjHandle &, const ObjHandle &) override { start(Op::XNOR);  }
+  void pre_op_mux   (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { start(Op::MUX);   }
+
+  void post_encode  (const ObjHandle &, const bit_plain_t) override { stop(Op::ENCODE);  }
+  void post_encrypt (const ObjHandle &, const bit_plain_t) override { stop(Op::ENCRYPT); }
+  void post_decrypt (const bit_plain_t, const ObjHandle &) override { stop(Op::DECRYPT); }
+  void post_read    (const ObjHandle &, const std::string &) override { stop(Op::READ);  }
+  void post_write   (const ObjHandle &, const std::string &) override { stop(Op::WRITE); }
+
+  void post_op_not  (const ObjHandle &, const ObjHandle &) override { stop(Op::NOT); }
+  void post_op_and  (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::AND);   }
+  void post_op_xor  (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::XOR);   }
+  void post_op_nand (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::NAND);  }
+  void post_op_andyn(const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::ANDYN); }
+  void post_op_andny(const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::ANDNY); }
+  void post_op_or   (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::OR);    }
+  void post_op_nor  (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::NOR);   }
+  void post_op_oryn (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::ORYN);  }
+  void post_op_orny (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::ORNY);  }
+  void post_op_xnor (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::XNOR);  }
+  void post_op_mux  (const ObjHandle &, const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::MUX);   }
+  /* clang-format on */
+};
+
+/**
+ * Other operations of IBitExecSHE are decomposed into AND and XOR gates,
+ * they are not timed to avoid counting a gate twice
+ */
+template <> class Profile_impl<IBitExecSHE> : public ProfileBase {
+public:
+  /* clang-format off */
+  void pre_encode   (const bit_plain_t) override                  { start(Op::ENCODE);  }
+  void pre_encrypt  (const bit_plain_t) override                  { start(Op::ENCRYPT); }
+  void pre_decrypt  (const ObjHandle &) override                  { start(Op::DECRYPT); }
+  void pre_read     (const std::string &) override                { start(Op::READ);    }
+  void pre_write    (const ObjHandle &, const std::string &) override { start(Op::WRITE); }
+
+  void pre_op_and   (const ObjHandle &, const ObjHandle &) override { start(Op::AND); }
+  void pre_op_xor   (const ObjHandle &, const ObjHandle &) override { start(Op::XOR); }
+
+  void post_encode  (const ObjHandle &, const bit_plain_t) override { stop(Op::ENCODE);  }
+  void post_encrypt (const ObjHandle &, const bit_plain_t) override { stop(Op::ENCRYPT); }
+  void post_decrypt (const bit_plain_t, const ObjHandle &) override { stop(Op::DECRYPT); }
+  void post_read    (const ObjHandle &, const std::string &) override { stop(Op::READ);  }
+  void post_write   (const ObjHandle &, const std::string &) override { stop(Op::WRITE); }
+
+  void post_op_and  (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::AND); }
+  void post_op_xor  (const ObjHandle &, const ObjHandle &,
+                     const ObjHandle &) override                  { stop(Op::XOR); }
+  /* clang-format on */
+};
+} // namespace
+
+} // namespace decorator
+} // namespace cingulata
+
+#endif
@@ -0,0 +1,266 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef BIT_EXEC_INTRUSIVE_HANDLE
+#define BIT_EXEC_INTRUSIVE_HANDLE
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#ifdef OBJ_HANDLE_THREAD_SAFE
+#include <atomic>
+#endif
+
+namespace cingulata {
+namespace intrusive {
+
+/**
+ * @brief      Control block shared by all handles pointing to an object
+ * @details    The reference counter is atomic only if @c OBJ_HANDLE_THREAD_SAFE
+ *             is defined. Function @c release is called when the last
+ *             handle is dropped, it must dispose the object and the block.
+ */
+struct CtrlBlock {
+#ifdef OBJ_HANDLE_THREAD_SAFE
+  std::atomic<unsigned> refcnt;
+#else
+  unsigned refcnt;
+#endif
+  void *obj;
+  void (*release)(CtrlBlock *);
+};
+
+/**
+ * @brief      Control block storing a deleter
+ * @details    Blocks are recycled through a per-thread free list (one list
+ *             per deleter type), thus after warm-up creating a handle does
+ *             not allocate memory. Blocks go to the list of the releasing
+ *             thread, which is bounded to #MAX_FREE blocks so that threads
+ *             only releasing handles (eg. workers of a parallel executor)
+ *             do not accumulate them. Once the list of a thread is
+ *             destroyed, blocks are allocated and freed directly.
+ *
+ * @tparam     Del   deleter type
+ */
+template <typename Del> struct DelCtrlBlock : public CtrlBlock {
+  Del del;
+  DelCtrlBlock *next_free;
+
+  struct FreeList;
+
+  DelCtrlBlock(void *p_obj, Del p_del) : del(std::move(p_del)) {
+    refcnt = 1;
+    obj = p_obj;
+    release = &DelCtrlBlock::release_block;
+  }
+
+  static DelCtrlBlock *create(void *p_obj, Del p_del) {
+    if (free_list_destroyed())
+      return new DelCtrlBlock(p_obj, std::move(p_del));
+
+    FreeList &list = free_list();
+    if (list.head == nullptr)
+      return new DelCtrlBlock(p_obj, std::move(p_del));
+
+    DelCtrlBlock *blk = list.head;
+    list.head = blk->next_free;
+    list.size--;
+    return new (blk) DelCtrlBlock(p_obj, std::move(p_del));
+  }
+
+  static void release_block(CtrlBlock *base) {
+    DelCtrlBlock *blk = static_cast<DelCtrlBlock *>(base);
+    blk->del(blk->obj);
+    blk->~DelCtrlBlock();
+
+    /* released after the thread local objects of calling thread were
+     * destroyed (eg. handle held by a static object), or list is full
+     * because this thread releases more handles than it creates */
+    if (free_list_destroyed() or free_list().size >= MAX_FREE) {
+      ::operator delete(blk);
+      return;
+    }
+
+    FreeList &list = free_list();
+    blk->next_free = list.head;
+    list.head = blk;
+    list.size++;
+  }
+
+  /**
+   * Maximal number of blocks kept by the free list of a thread
+   */
+  static constexpr unsigned MAX_FREE = 4096;
+
+  static FreeList &free_list() {
+    static thread_local FreeList list;
+    return list;
+  }
+
+  /**
+   * Set once the free list of calling thread is destroyed, trivially
+   * destructible thus still readable afterwards
+   */
+  static bool &free_list_destroyed() {
+    static thread_local bool destroyed = false;
+    return destroyed;
+  }
+
+  /* Releases raw block memory at thread exit */
+  struct FreeList {
+    DelCtrlBlock *head = nullptr;
+    unsigned size = 0;
+    ~FreeList() {
+      free_list_destroyed() = true;
+      while (head != nullptr) {
+        DelCtrlBlock *next = head->next_free;
+        ::operator delete(head);
+        head = next;
+      }
+    }
+  };
+};
+
+/**
+ * @brief      Typed intrusive reference counted handle
+ * @details    Same usage as a @c std::shared_ptr, but the reference counter
+ *             lives in a recycled control block and copies do not use atomic
+ *             operations in single-threaded builds.
+ *
+ * @tparam     T     object type
+ */
+template <typename T> class HandleT {
+public:
+  using element_type = T;
+
+  HandleT() = default;
+
+  /**
+   * @brief      Construct a handle for an existing object
+   *
+   * @param      ptr   pointer to an object
+   * @param      d     deleter functionality
+   */
+  template <typename U, typename Del>
+  HandleT(U *ptr, Del d)
+      : m_blk(DelCtrlBlock<Del>::create(static_cast<T *>(ptr), std::move(d))) {}
+
+  HandleT(const HandleT &other) : m_blk(other.m_blk) { acquire(); }
+
+  HandleT(HandleT &&other) noexcept : m_blk(other.m_blk) {
+    other.m_blk = nullptr;
+  }
+
+  /**
+   * @brief      Converting constructor from a handle of another type
+   */
+  template <typename U>
+  explicit HandleT(const HandleT<U> &other) : m_blk(other.ctrl_block()) {
+    acquire();
+  }
+
+  ~HandleT() { drop(); }
+
+  HandleT &operator=(const HandleT &other) {
+    if (m_blk != other.m_blk) {
+      HandleT tmp(other);
+      std::swap(m_blk, tmp.m_blk);
+    }
+    return *this;
+  }
+
+  HandleT &operator=(HandleT &&other) noexcept {
+    /* previous object is released by tmp */
+    HandleT tmp(std::move(other));
+    std::swap(m_blk, tmp.m_blk);
+    return *this;
+  }
+
+  /**
+   * @brief      Release the pointed object
+   */
+  void reset() {
+    drop();
+    m_blk = nullptr;
+  }
+
+  /**
+   * @brief      Return stored pointer
+   */
+  T *get() const {
+    return m_blk == nullptr ? nullptr : static_cast<T *>(m_blk->obj);
+  }
+
+  template <typename U = T> U &operator*() const { return *get(); }
+
+  T *operator->() const { return get(); }
+
+  explicit operator bool() const { return m_blk != nullptr; }
+
+  /**
+   * @brief      Number of handles pointing to the object
+   */
+  long use_count() const { return m_blk == nullptr ? 0 : (long)m_blk->refcnt; }
+
+  CtrlBlock *ctrl_block() const { return m_blk; }
+
+private:
+  void acquire() {
+    if (m_blk != nullptr)
+      ++m_blk->refcnt;
+  }
+
+  void drop() {
+    if (m_blk != nullptr and --m_blk->refcnt == 0)
+      m_blk->release(m_blk);
+  }
+
+  CtrlBlock *m_blk = nullptr;
+};
+
+/**
+ * @brief      Handles are equal when they store the same pointer, as for
+ *             @c std::shared_ptr
+ */
+template <typename T, typename U>
+bool operator==(const HandleT<T> &lhs, const HandleT<U> &rhs) {
+  return static_cast<const void *>(lhs.get()) ==
+         static_cast<const void *>(rhs.get());
+}
+
+template <typename T, typename U>
+bool operator!=(const HandleT<T> &lhs, const HandleT<U> &rhs) {
+  return not(lhs == rhs);
+}
+
+/**
+ * @brief      Cast between intrusive handles, counterpart of
+ *             @c std::static_pointer_cast
+ */
+template <typename T, typename U>
+HandleT<T> static_pointer_cast(const HandleT<U> &hdl) {
+  return HandleT<T>(hdl);
+}
+
+} // namespace intrusive
+} // namespace cingulata
+
+#endif
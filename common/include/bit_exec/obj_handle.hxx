@@ -21,19 +21,33 @@
 #ifndef BIT_EXEC_OBJ_HANDLE
 #define BIT_EXEC_OBJ_HANDLE
 
+#ifdef OBJ_HANDLE_INTRUSIVE
+#include "intrusive_handle.hxx"
+#else
 #include <memory>
+#endif
 
 namespace cingulata
 {
+#ifdef OBJ_HANDLE_INTRUSIVE
+  /**
+   * Typed object handle, implemented as an intrusive reference counted
+   * handle (see @c intrusive::HandleT)
+   */
+  template<typename T>
+  using ObjHandleT = intrusive::HandleT<T>;
+#else
   /**
    * Typed object handle, implemented as a shared pointer
    */
   template<typename T>
   using ObjHandleT = std::shared_ptr<T>;
+#endif
 
   /**
    * @brief Generic object handle
-   * @details Implementation based on a shared pointer to void
+   * @details Implementation based on a shared pointer to void or, when
+   *  @c OBJ_HANDLE_INTRUSIVE is defined, on an intrusive handle to void
    */
   class ObjHandle : public ObjHandleT<void>
   {
@@ -52,7 +66,7 @@ namespace cingulata
      * @tparam _Del deleter type
      */
     template<typename T, typename _Del>
-    ObjHandle(T* ptr, _Del d) : std::shared_ptr<void>(ptr, d) {}
+    ObjHandle(T* ptr, _Del d) : ObjHandleT<void>(ptr, d) {}
 
     /**
      * @brief Copy-construct a generic handle from a typed object handle
@@ -77,7 +91,11 @@ namespace cingulata
      */
     template<typename T>
     operator ObjHandleT<T> () const {
+#ifdef OBJ_HANDLE_INTRUSIVE
+      return ObjHandleT<T>(static_cast<const ObjHandleT<void>&>(*this));
+#else
       return std::static_pointer_cast<T>(*this);
+#endif
     }
 
     /**
@@ -89,7 +107,7 @@ namespace cingulata
      */
     template<typename T>
     T* get() const {
-      return ((ObjHandleT<T>)*this).get();
+      return static_cast<T*>(ObjHandleT<void>::get());
     }
   };
 }
@@ -26,6 +26,11 @@ Basic<AllocT>::Basic(const AllocT &alloc)
 template <typename AllocT>
 template <typename... Args>
 ObjHandle Basic<AllocT>::new_handle(Args... args) {
+  const bool counted = live_obj_new();
   return ObjHandle(m_alloc.new_obj(std::forward<args>...),
-                   [this](void *ptr) { m_alloc.del_obj(ptr); });
+                   [this, counted](void *ptr) {
+                     if (counted)
+                       live_obj_del();
+                     m_alloc.del_obj(ptr);
+                   });
 }
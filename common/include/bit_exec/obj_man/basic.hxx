@@ -23,6 +23,7 @@
 
 #include <bit_exec/obj_handle.hxx>
 #include <bit_exec/obj_man/allocator.hxx>
+#include <bit_exec/obj_man/live_cnt.hxx>
 
 namespace cingulata {
 namespace obj_man {
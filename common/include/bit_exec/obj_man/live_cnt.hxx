@@ -0,0 +1,73 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef MEM_LIVE_CNT
+#define MEM_LIVE_CNT
+
+#include <atomic>
+
+namespace cingulata {
+namespace obj_man {
+
+/**
+ * @brief      Number of objects handed out by object managers and not yet
+ *             released, over all managers of the process. Only objects
+ *             created while counting is enabled (cf. #live_obj_cnt_users)
+ *             are counted.
+ */
+inline std::atomic<long> &live_obj_cnt() {
+  static std::atomic<long> cnt(0);
+  return cnt;
+}
+
+/**
+ * @brief      Number of users of the live object counter (eg. profiling
+ *             decorators). Objects are counted only while it is non-zero,
+ *             otherwise object managers do not touch the shared counter.
+ */
+inline std::atomic<int> &live_obj_cnt_users() {
+  static std::atomic<int> cnt(0);
+  return cnt;
+}
+
+/**
+ * @brief      Counts a new object if counting is enabled
+ *
+ * @return     true if the object is counted, in which case #live_obj_del
+ *             must be called when it is released
+ */
+inline bool live_obj_new() {
+  if (live_obj_cnt_users().load(std::memory_order_relaxed) == 0)
+    return false;
+  live_obj_cnt().fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * @brief      Uncounts a released object counted by #live_obj_new
+ */
+inline void live_obj_del() {
+  live_obj_cnt().fetch_sub(1, std::memory_order_relaxed);
+}
+
+} // namespace obj_man
+} // namespace cingulata
+
+#endif
@@ -18,15 +18,16 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+template <typename AllocT, bool Concurrent>
+Pool<AllocT, Concurrent>::Pool(const AllocT &alloc) : m_alloc(alloc) {}
 
-template <typename AllocT>
-Pool<AllocT>::Pool(const AllocT &alloc) : m_alloc(alloc) {}
-
-template <typename AllocT> Pool<AllocT>::~Pool() {
+template <typename AllocT, bool Concurrent>
+Pool<AllocT, Concurrent>::~Pool() {
   clear();
 }
 
-template <typename AllocT> void Pool<AllocT>::clear() {
+template <typename AllocT, bool Concurrent>
+void Pool<AllocT, Concurrent>::clear() {
   while (not m_alloc_obj.empty()) {
     void *ptr = m_alloc_obj.back();
     m_alloc_obj.pop_back();
@@ -36,9 +37,9 @@ template <typename AllocT> void Pool<AllocT>::clear() {
 
 
 
-template <typename AllocT>
+template <typename AllocT, bool Concurrent>
 template <typename... Args>
-ObjHandle Pool<AllocT>::new_handle(Args... args) {
+ObjHandle Pool<AllocT, Concurrent>::new_handle(Args... args) {
   void *ptr = nullptr;
   if (m_alloc_obj.empty()) {
     ptr = m_alloc.new_obj(std::forward<Args>(args)...);
@@ -46,9 +47,166 @@ ObjHandle Pool<AllocT>::new_handle(Args... args) {
     ptr = m_alloc_obj.back();
     m_alloc_obj.pop_back();
   }
-  return ObjHandle(ptr, [this](void *ptr) { store_obj(ptr); });
+  const bool counted = live_obj_new();
+  return ObjHandle(ptr, [this, counted](void *ptr) {
+    if (counted)
+      live_obj_del();
+    store_obj(ptr);
+  });
 }
 
-template <typename AllocT> void Pool<AllocT>::store_obj(void *ptr) {
+template <typename AllocT, bool Concurrent>
+void Pool<AllocT, Concurrent>::store_obj(void *ptr) {
   m_alloc_obj.push_back(ptr);
 }
+
+/**
+ * Concurrent pool implementation
+ */
+
+template <typename AllocT>
+Pool<AllocT, true>::Pool(const AllocT &alloc, const size_t max_retained)
+    : m_free_list(nullptr), m_retained(0), m_max_retained(max_retained),
+      m_alloc(alloc) {}
+
+template <typename AllocT> Pool<AllocT, true>::~Pool() {
+  clear();
+}
+
+template <typename AllocT>
+typename Pool<AllocT, true>::Cache &Pool<AllocT, true>::lock_cache() {
+  static std::atomic<size_t> thread_cnt(0);
+  thread_local size_t slot = thread_cnt++ % CACHE_CNT;
+
+  Cache &cache = m_caches[slot];
+  while (cache.lock.test_and_set(std::memory_order_acquire))
+    ;
+  return cache;
+}
+
+template <typename AllocT>
+void Pool<AllocT, true>::unlock_cache(Cache &cache) {
+  cache.lock.clear(std::memory_order_release);
+}
+
+template <typename AllocT>
+void Pool<AllocT, true>::push_batches(Batch *first, Batch *last) {
+  /* pushing is ABA-safe: only the head is compared */
+  last->next = m_free_list.load(std::memory_order_relaxed);
+  while (not m_free_list.compare_exchange_weak(
+      last->next, first, std::memory_order_release, std::memory_order_relaxed))
+    ;
+}
+
+template <typename AllocT>
+typename Pool<AllocT, true>::Batch *Pool<AllocT, true>::pop_batch() {
+  if (m_free_list.load(std::memory_order_relaxed) == nullptr)
+    return nullptr;
+
+  /* take the whole list (ABA-free), keep the first batch and give back the
+   * remaining ones */
+  Batch *first = m_free_list.exchange(nullptr, std::memory_order_acquire);
+  if (first == nullptr)
+    return nullptr;
+
+  Batch *rest = first->next;
+  if (rest != nullptr) {
+    Batch *last = rest;
+    while (last->next != nullptr)
+      last = last->next;
+    push_batches(rest, last);
+  }
+
+  first->next = nullptr;
+  m_retained -= first->cnt;
+  return first;
+}
+
+template <typename AllocT>
+void Pool<AllocT, true>::del_batch(Batch *batch) {
+  for (size_t i = 0; i < batch->cnt; ++i)
+    m_alloc.del_obj(batch->objs[i]);
+  delete batch;
+}
+
+template <typename AllocT> void Pool<AllocT, true>::clear() {
+  for (Cache &cache : m_caches) {
+    while (cache.lock.test_and_set(std::memory_order_acquire))
+      ;
+    if (cache.batch != nullptr) {
+      del_batch(cache.batch);
+      cache.batch = nullptr;
+    }
+    cache.lock.clear(std::memory_order_release);
+  }
+
+  shrink_to_fit();
+}
+
+template <typename AllocT> void Pool<AllocT, true>::shrink_to_fit() {
+  Batch *batch = m_free_list.exchange(nullptr, std::memory_order_acquire);
+  while (batch != nullptr) {
+    Batch *next = batch->next;
+    m_retained -= batch->cnt;
+    del_batch(batch);
+    batch = next;
+  }
+}
+
+template <typename AllocT> size_t Pool<AllocT, true>::retained() const {
+  return m_retained.load(std::memory_order_relaxed);
+}
+
+template <typename AllocT>
+template <typename... Args>
+ObjHandle Pool<AllocT, true>::new_handle(Args... args) {
+  void *ptr = nullptr;
+
+  Cache &cache = lock_cache();
+  if (cache.batch == nullptr or cache.batch->cnt == 0) {
+    Batch *batch = pop_batch();
+    if (batch != nullptr) {
+      delete cache.batch;
+      cache.batch = batch;
+    }
+  }
+  if (cache.batch != nullptr and cache.batch->cnt > 0) {
+    ptr = cache.batch->objs[--cache.batch->cnt];
+  }
+  unlock_cache(cache);
+
+  if (ptr == nullptr) {
+    ptr = m_alloc.new_obj(std::forward<Args>(args)...);
+  }
+
+  const bool counted = live_obj_new();
+  return ObjHandle(ptr, [this, counted](void *ptr) {
+    if (counted)
+      live_obj_del();
+    store_obj(ptr);
+  });
+}
+
+template <typename AllocT>
+void Pool<AllocT, true>::store_obj(void *ptr) {
+  Batch *full = nullptr;
+
+  Cache &cache = lock_cache();
+  if (cache.batch == nullptr) {
+    cache.batch = new Batch();
+  } else if (cache.batch->cnt == BATCH_SIZE) {
+    full = cache.batch;
+    cache.batch = new Batch();
+  }
+  cache.batch->objs[cache.batch->cnt++] = ptr;
+  unlock_cache(cache);
+
+  if (full != nullptr) {
+    if (m_retained.fetch_add(full->cnt) + full->cnt <= m_max_retained) {
+      push_batches(full, full);
+    } else {
+      m_retained -= full->cnt;
+      del_batch(full);
+    }
+  }
+}
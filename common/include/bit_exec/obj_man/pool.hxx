@@ -23,7 +23,10 @@
 
 #include <bit_exec/obj_handle.hxx>
 #include <bit_exec/obj_man/allocator.hxx>
+#include <bit_exec/obj_man/live_cnt.hxx>
 
+#include <atomic>
+#include <cstddef>
 #include <deque>
 
 namespace cingulata {
@@ -36,9 +39,11 @@ namespace obj_man {
  *             is created or an existing one (created and returned to object
  *             pool earlier) is returned.
  *
- * @tparam     AllocT  Allocator type
+ * @tparam     AllocT      Allocator type
+ * @tparam     Concurrent  Use the thread-safe implementation (see
+ *                         specialization below)
  */
-template <typename AllocT> class Pool {
+template <typename AllocT, bool Concurrent = false> class Pool {
 public:
   /**
    * @brief      Constructs the object pool memory management object
@@ -75,6 +80,93 @@ protected:
   const AllocT &m_alloc;
 };
 
+/**
+ * @brief      Thread-safe object pool management class
+ * @details    Object handles can be created and released from any thread.
+ *             Each thread uses its own cache of free objects (threads are
+ *             mapped to a fixed set of cache slots, each one guarded by an
+ *             uncontended spin lock). Caches exchange full batches of objects
+ *             with a lock-free global list. The number of objects kept in
+ *             the global list is bounded, objects released beyond this bound
+ *             are deleted.
+ *
+ * @tparam     AllocT  Allocator type, its methods must be thread-safe
+ */
+template <typename AllocT> class Pool<AllocT, true> {
+public:
+  /**
+   * @brief      Constructs the concurrent object pool
+   *
+   * @param[in]  alloc         The allocator to use
+   * @param[in]  max_retained  Maximal number of free objects kept in the
+   *                           global list
+   */
+  Pool(const AllocT &alloc = AllocT(), const size_t max_retained = 1 << 16);
+
+  /**
+   * @brief      Destroys pool and its objects
+   */
+  ~Pool();
+
+  /**
+   * @brief      Create a generic object handle
+   *
+   * @param[in]  args  parameters to pass to @c AllocT object create method.
+   *
+   * @tparam     Args  parameter pack
+   *
+   * @return     a new generic object handle
+   */
+  template <typename... Args> ObjHandle new_handle(Args... args);
+
+  /**
+   * @brief      Destroys all free objects in pool (per-thread caches and
+   *             global list)
+   */
+  void clear();
+
+  /**
+   * @brief      Destroys free objects in the global list, per-thread caches
+   *             are kept
+   */
+  void shrink_to_fit();
+
+  /**
+   * @brief      Number of free objects in the global list
+   */
+  size_t retained() const;
+
+protected:
+  static constexpr size_t BATCH_SIZE = 64;
+  static constexpr size_t CACHE_CNT = 64;
+
+  struct Batch {
+    Batch *next = nullptr;
+    size_t cnt = 0;
+    void *objs[BATCH_SIZE];
+  };
+
+  struct alignas(64) Cache {
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    Batch *batch = nullptr;
+  };
+
+  void store_obj(void *ptr);
+
+  Cache &lock_cache();
+  void unlock_cache(Cache &cache);
+
+  void push_batches(Batch *first, Batch *last);
+  Batch *pop_batch();
+  void del_batch(Batch *batch);
+
+  Cache m_caches[CACHE_CNT];
+  std::atomic<Batch *> m_free_list;
+  std::atomic<size_t> m_retained;
+  const size_t m_max_retained;
+  const AllocT &m_alloc;
+};
+
 #include "pool-impl.hxx"
 
 } // namespace obj_man
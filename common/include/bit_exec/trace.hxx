@@ -0,0 +1,158 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef BIT_EXEC_TRACE
+#define BIT_EXEC_TRACE
+
+#include <bit_exec/interface.hxx>
+
+#include <initializer_list>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace cingulata {
+
+/**
+ * @brief      Compiled boolean circuit, recorded once and replayed on any bit
+ *             executor
+ * @details    Nodes are stored in topological order in a flat array and
+ *             reference their inputs by index. Replaying a trace evaluates
+ *             the circuit directly with @c IBitExec operations, without
+ *             re-running the program which produced it. Intermediate objects
+ *             are released as soon as their last consumer is evaluated.
+ */
+class Trace {
+public:
+  enum class Op : uint8_t {
+    INPUT,
+    ZERO,
+    ONE,
+    NOT,
+    BUF,
+    AND,
+    NAND,
+    ANDNY,
+    ANDYN,
+    OR,
+    NOR,
+    ORNY,
+    ORYN,
+    XOR,
+    XNOR,
+    MUX
+  };
+
+  /**
+   * @brief      Circuit node, for input nodes @c inps[0] is the input index
+   */
+  struct Node {
+    Op op;
+    uint32_t inps[3];
+  };
+
+  /**
+   * @brief      Appends an input node
+   *
+   * @param[in]  name  input name, empty for anonymous inputs
+   *
+   * @return     node index
+   */
+  uint32_t add_input(const std::string &name = "");
+
+  /**
+   * @brief      Appends a gate node
+   *
+   * @param[in]  op    gate type
+   * @param[in]  inps  indices of input nodes, must be already in the trace
+   *
+   * @return     node index
+   */
+  uint32_t add_gate(const Op op, const std::initializer_list<uint32_t> inps);
+
+  /**
+   * @brief      Marks node @c node as a circuit output
+   *
+   * @param[in]  node  node index
+   * @param[in]  name  output name, empty for anonymous outputs
+   */
+  void add_output(const uint32_t node, const std::string &name = "");
+
+  /**
+   * @brief      Removes all nodes
+   */
+  void clear();
+
+  const std::vector<Node> &nodes() const { return m_nodes; }
+  const std::vector<std::string> &input_names() const { return m_input_names; }
+  const std::vector<std::string> &output_names() const {
+    return m_output_names;
+  }
+
+  /**
+   * @brief      Number of gate levels (circuit depth)
+   */
+  unsigned depth() const { return m_levels.size(); }
+
+  /**
+   * @brief      Evaluates the circuit on bit executor @c exec
+   * @details    With @c nr_threads larger than 1 a pool of @c nr_threads
+   *             workers evaluates each gate as soon as all its inputs are
+   *             available, in this case @c exec must be usable from several
+   *             threads.
+   *
+   * @param      exec        bit executor
+   * @param[in]  inps        handles of circuit inputs, in input order
+   * @param[in]  nr_threads  number of threads to use
+   *
+   * @return     handles of circuit outputs, in output order
+   */
+  std::vector<ObjHandle> replay(IBitExec &exec,
+                                const std::vector<ObjHandle> &inps,
+                                const unsigned nr_threads = 1) const;
+
+  /**
+   * @brief      Reads circuit inputs, evaluates the circuit and writes its
+   *             outputs using @c exec read/write methods
+   * @details    All inputs and outputs must be named.
+   *
+   * @param      exec        bit executor
+   * @param[in]  nr_threads  number of threads to use
+   */
+  void run(IBitExec &exec, const unsigned nr_threads = 1) const;
+
+protected:
+  ObjHandle eval(IBitExec &exec, const Node &node,
+                 const std::vector<ObjHandle> &vals,
+                 const std::vector<ObjHandle> &inps) const;
+
+  std::vector<Node> m_nodes;
+  std::vector<uint32_t> m_nr_uses;
+  std::vector<uint32_t> m_node_level;
+  std::vector<std::vector<uint32_t>> m_levels;
+
+  std::vector<std::string> m_input_names;
+  std::vector<uint32_t> m_outputs;
+  std::vector<std::string> m_output_names;
+};
+
+} // namespace cingulata
+
+#endif
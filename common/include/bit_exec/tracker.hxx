@@ -21,19 +21,26 @@
 #ifndef BIT_TRACKER
 #define BIT_TRACKER
 
+#include <bit_exec/interface_fhe.hxx>
 #include <bit_exec/interface_she.hxx>
-#include <bit_exec/obj_man/allocator.hxx>
-#include <bit_exec/obj_man/basic.hxx>
+#include <bit_exec/trace.hxx>
 
+#include <array>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace cingulata {
 namespace BitTrackerInternal {
-class Node;
-enum class NodeType : uint8_t;
+struct NodeTable;
+struct BlifStream;
 enum class GateType : uint8_t;
+
+/**
+ * @brief Gate inputs, unused entries are zero
+ */
+typedef std::array<uint32_t, 3> NodeInps;
 } // namespace BitTrackerInternal
 namespace BTI = BitTrackerInternal;
 
@@ -41,9 +48,24 @@ namespace BTI = BitTrackerInternal;
  * @brief Implemenation class for bit execution interface which tracks
  *  bit operations. This class constructs a boolean circuit corresponding
  *  to every called interface operation.
+ * @details Gates are simplified on the fly: gates with constant or
+ *  duplicate inputs are rewritten and structurally identical gates are
+ *  shared. Thus an operation can return a handle equal to an existing one.
+ *  Nodes are stored in a compact table and handles only hold node indices,
+ *  therefore handles are meaningless outside of the tracker which created
+ *  them and are invalidated by @c reset.
  */
 class BitTracker : public IBitExecSHE {
 public:
+  /**
+   * @brief Target gate library of circuit lowering
+   */
+  enum class GateLib {
+    SHE, ///< AND, XOR and NOT gates (ie B/FV)
+    FHE  ///< all gate types, with native multiplexer (ie TFHE)
+  };
+
+  BitTracker();
   ~BitTracker() override;
 
   /* clang-format off */
@@ -83,18 +105,104 @@ public:
   void export_blif(const std::string &file_name,
                    const std::string &model_name = "CIRCUIT");
 
+  /**
+   * @brief      Starts streaming export of the circuit in BLIF format
+   * @details    From now on, each node is written to @c stream as soon as it
+   *             is created, named after its integer identifier, and is
+   *             released once no longer referenced. Thus tracing memory is
+   *             proportional to the number of live nodes. The circuit
+   *             constructed so far is deleted and streamed nodes are not
+   *             kept, methods @c export_blif, @c export_trace and @c lower
+   *             do not see them.
+   *
+   * @param      stream      output stream, must outlive streaming
+   * @param[in]  model_name  BLIF model name
+   */
+  void stream_blif(std::ostream &stream,
+                   const std::string &model_name = "CIRCUIT");
+
+  /**
+   * @brief      Starts streaming export of the circuit to file @c file_name
+   *
+   * @param[in]  file_name   output file name
+   * @param[in]  model_name  BLIF model name
+   */
+  void stream_blif(const std::string &file_name,
+                   const std::string &model_name = "CIRCUIT");
+
+  /**
+   * @brief      Ends streaming export, called by @c reset and destructor
+   * @details    Handles of streamed nodes are invalidated.
+   */
+  void stream_end();
+
+  /**
+   * @brief      Compiles the boolean circuit constructed so far into a trace
+   *             which can be replayed on any bit executor
+   *
+   * @return     circuit trace
+   */
+  Trace export_trace() const;
+
+  /**
+   * @brief      Rewrites the boolean circuit constructed so far with gates of
+   *             library @c lib
+   * @details    Gates missing from the library are decomposed and, when the
+   *             library permits it, negations are absorbed into gates and
+   *             AND/XOR multiplexer patterns are fused. Alternatives are
+   *             chosen using per-library gate costs (multiplications for
+   *             SHE, bootstrappings for FHE). This method should be called
+   *             once the circuit is fully tracked.
+   *
+   * @param[in]  lib   target gate library
+   */
+  void lower(const GateLib lib);
+
 protected:
-  obj_man::Basic<obj_man::Allocator<BTI::Node>> mm;
+  ObjHandle handle(const uint32_t node);
+  static uint32_t node(const ObjHandle &hdl);
+
+  uint32_t add_gate(BTI::GateType gate_type,
+                    const std::initializer_list<uint32_t> inps_p);
+  uint32_t new_node(BTI::GateType gate_type, const BTI::NodeInps &inps);
+  uint32_t simplify(BTI::GateType &gate_type, BTI::NodeInps &inps);
+  uint32_t add_input(const std::string &name = "");
+  void make_output(const uint32_t node, const std::string &name = "");
+
+  /* node table, shared with handles of streamed nodes */
+  std::shared_ptr<BTI::NodeTable> nodes;
 
-  ObjHandle add_gate(BTI::GateType gate_type,
-                     const std::initializer_list<ObjHandleT<BTI::Node>> inps_p);
-  ObjHandle add_input(const std::string &name = "");
-  void make_output(const ObjHandleT<BTI::Node> &hdl,
-                   const std::string &name = "");
+  std::vector<uint32_t> inputs;
+  std::vector<uint32_t> gates;
+  std::vector<uint32_t> outputs;
 
-  std::vector<ObjHandleT<BTI::Node>> inputs;
-  std::vector<ObjHandleT<BTI::Node>> gates;
-  std::vector<ObjHandleT<BTI::Node>> outputs;
+  void stream_node(const uint32_t node);
+  std::unique_ptr<BTI::BlifStream> blif_stream;
+};
+
+/**
+ * @brief Bit tracker which records every gate type natively instead of
+ *  decomposing it into AND and XOR gates. The tracked circuit is adapted for
+ *  FHE schemes with a rich gate set (ie TFHE).
+ */
+class BitTrackerFHE : public BitTracker {
+public:
+  typedef IBitExecFHE interface_type;
+
+  /* clang-format off */
+  ObjHandle   op_not      (const ObjHandle& in1)                          override;
+  ObjHandle   op_nand     (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_andyn    (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_andny    (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_or       (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_nor      (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_oryn     (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_orny     (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_xnor     (const ObjHandle& in1, const ObjHandle& in2)    override;
+
+  ObjHandle   op_mux      (const ObjHandle& cond,
+                            const ObjHandle& in1, const ObjHandle& in2)   override;
+  /* clang-format on */
 };
 } // namespace cingulata
 
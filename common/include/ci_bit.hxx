@@ -192,6 +192,15 @@ namespace cingulata
      */
     bool is_plain() const;
 
+    /**
+     * @brief      Get underlying object handle
+     * @details    Handle is empty when bit is plain. Copies of an object
+     *             share the same handle.
+     *
+     * @return     object handle
+     */
+    const ObjHandle& get_obj_handle() const;
+
     /**
      * @name Boolean operations with plain-text input
      * @{
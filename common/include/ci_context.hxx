@@ -40,6 +40,8 @@ public:
    */
   static void set_bit_exec(const std::shared_ptr<IBitExec> &p_bit_exec) {
     m_bit_exec = p_bit_exec;
+    if (m_int_op_gen)
+      m_int_op_gen->reset();
   }
 
   /**
@@ -73,6 +75,8 @@ public:
    */
   static void set_int_op_gen(const std::shared_ptr<IIntOpGen> &p_int_op_gen) {
     m_int_op_gen = p_int_op_gen;
+    if (m_int_op_gen)
+      m_int_op_gen->reset();
   }
 
   /**
@@ -106,6 +110,18 @@ public:
     set_int_op_gen(p_int_op_gen);
   }
 
+  /**
+   * @brief      Reset bit executor and integer operation generator. Use it
+   *             instead of resetting the bit executor directly, as the
+   *             generator may keep bits of the executor (eg. memoization)
+   */
+  static void reset() {
+    if (m_bit_exec)
+      m_bit_exec->reset();
+    if (m_int_op_gen)
+      m_int_op_gen->reset();
+  }
+
 protected:
   static std::shared_ptr<IBitExec> m_bit_exec;
   static std::shared_ptr<IIntOpGen> m_int_op_gen;
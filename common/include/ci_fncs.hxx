@@ -39,6 +39,22 @@ namespace cingulata {
    */
   CiInt select(const CiBit &cond, const CiInt &a, const CiInt &b);
 
+  /**
+   * @brief      Oblivious table lookup.
+   * @details    This function is an equivalent of @c table[idx], where @c idx
+   *             is an unsigned integer. Zero is returned when @c idx is out
+   *             of range, the cost depends on the table size rather than on
+   *             the index bit-size. Table elements are cast to the
+   *             largest element bit-size, the result is signed if all table
+   *             elements are signed.
+   *
+   * @param[in]  idx    The index
+   * @param[in]  table  The table, usually plain-text (eg. an S-box)
+   *
+   * @return     obliviously selected integer
+   */
+  CiInt lookup(const CiInt &idx, const std::vector<CiInt> &table);
+
   /**
    * @brief      Sums-up a list of integers.
    * @details    Resulting @c CiInt object is minimal in bit-size.
@@ -59,6 +75,17 @@ namespace cingulata {
    */
   CiInt sum(const std::vector<CiBit> &elems);
 
+  /**
+   * @brief      Counts bits set in an integer (Hamming weight).
+   * @details    Resulting @c CiInt object is unsigned and minimal in
+   *             bit-size.
+   *
+   * @param[in]  val   The integer
+   *
+   * @return     Number of bits set in @c val
+   */
+  CiInt popcount(const CiInt &val);
+
   /**
    * @brief      Oblivious sort a vector of @c CiInt objects @c vals
    *
@@ -98,6 +125,84 @@ namespace cingulata {
   std::vector<CiInt> argsort(const std::vector<CiInt> &vals,
                              const bool reverse = false);
 
+  /**
+   * @brief      Oblivious minimum of a non-empty vector of @c CiInt objects.
+   * @details    Integers are compared after a cast to the largest bit-size,
+   *             as signed integers if all of them are signed. The minimum is
+   *             selected with a tournament tree, using @c vals.size()-1
+   *             comparators.
+   *
+   * @param[in]  vals  The elements
+   *
+   * @return     Smallest element
+   */
+  CiInt min(const std::vector<CiInt> &vals);
+
+  /**
+   * @brief      Oblivious maximum of a non-empty vector of @c CiInt objects.
+   * @details    @copydetails min
+   *
+   * @param[in]  vals  The elements
+   *
+   * @return     Largest element
+   */
+  CiInt max(const std::vector<CiInt> &vals);
+
+  /**
+   * @brief      Oblivious index (encrypted) of the minimum of a non-empty
+   *             vector of @c CiInt objects.
+   * @details    Indices are selected together with the compared elements,
+   *             thus the cost is the same as for #min. The first index is
+   *             returned when several elements are equal to the minimum.
+   *
+   * @param[in]  vals  The elements
+   *
+   * @return     Index of smallest element
+   */
+  CiInt argmin(const std::vector<CiInt> &vals);
+
+  /**
+   * @brief      Oblivious index (encrypted) of the maximum of a non-empty
+   *             vector of @c CiInt objects.
+   * @details    @copydetails argmin
+   *
+   * @param[in]  vals  The elements
+   *
+   * @return     Index of largest element
+   */
+  CiInt argmax(const std::vector<CiInt> &vals);
+
+  /**
+   * @brief      Oblivious selection of the @c k smallest @c CiInt objects
+   *             of @c vals, the @c k largest if @c reverse is set.
+   * @details    The result is the same as the first @c k elements of #sort
+   *             but it uses @c O(N.log2(k)^2) comparators.
+   *
+   * @param[in]  vals     The elements
+   * @param[in]  k        Number of elements to select
+   * @param[in]  reverse  The selection order
+   *
+   * @return     Selected elements, sorted
+   */
+  std::vector<CiInt> top_k(const std::vector<CiInt> &vals, const unsigned k,
+                           const bool reverse = false);
+
+  /**
+   * @brief      Oblivious selection of the @c CiInt objects of @c elems
+   *             corresponding to the @c k smallest values in vector @c vals
+   *             (the @c k largest if @c reverse is set).
+   *
+   * @param[in]  vals     Values to use for comparison
+   * @param[in]  elems    The elements to select
+   * @param[in]  k        Number of elements to select
+   * @param[in]  reverse  The selection order
+   *
+   * @return     Selected elements, sorted by values
+   */
+  std::vector<CiInt> top_k(const std::vector<CiInt> &vals,
+                           const std::vector<CiInt> &elems, const unsigned k,
+                           const bool reverse = false);
+
   } // namespace cingulata
 
 #endif // CI_FNCS
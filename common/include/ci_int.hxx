@@ -374,8 +374,8 @@ namespace cingulata
     CiInt&  operator  +=  (const CiInt& other);
     CiInt&  operator  -=  (const CiInt& other);
     CiInt&  operator  *=  (const CiInt& other);
-    // CiInt&  operator  /=  (const CiInt& other);
-    // CiInt&  operator  %=  (const CiInt& other);
+    CiInt&  operator  /=  (const CiInt& other);
+    CiInt&  operator  %=  (const CiInt& other);
 
     CiInt&  operator  ++  ();
     CiInt&  operator  --  ();
@@ -470,8 +470,16 @@ namespace cingulata
   CiInt   operator  +   (const CiInt& lhs, const CiInt& rhs);
   CiInt   operator  -   (const CiInt& lhs, const CiInt& rhs);
   CiInt   operator  *   (const CiInt& lhs, const CiInt& rhs);
-  // CiInt   operator  /   (const CiInt& lhs, const CiInt& rhs);
-  // CiInt   operator  %   (const CiInt& lhs, const CiInt& rhs);
+  /**
+   * @brief      Integer division, rounded towards zero
+   * @details    The result of division by zero is undefined
+   */
+  CiInt   operator  /   (const CiInt& lhs, const CiInt& rhs);
+
+  /**
+   * @brief      Remainder of integer division, it has the sign of @c lhs
+   */
+  CiInt   operator  %   (const CiInt& lhs, const CiInt& rhs);
 
   /* Bitwise logic */
   CiInt   operator  ~   (const CiInt& lhs);
@@ -485,6 +493,16 @@ namespace cingulata
   CiInt   rol           (CiInt lhs, const int pos);
   CiInt   ror           (CiInt lhs, const int pos);
 
+  /**
+   * @brief      Shift/rotate by a ciphertext number of positions
+   * @details    Amount @c pos is interpreted as an unsigned integer. Right
+   *             shift replicates the sign bit of @c lhs.
+   */
+  CiInt   operator  <<  (const CiInt& lhs, const CiInt& pos);
+  CiInt   operator  >>  (const CiInt& lhs, const CiInt& pos);
+  CiInt   rol           (const CiInt& lhs, const CiInt& pos);
+  CiInt   ror           (const CiInt& lhs, const CiInt& pos);
+
   /* Relational operators */
   CiBit   operator  ==  (const CiInt& lhs, const CiInt& rhs);
   CiBit   operator  !=  (const CiInt& lhs, const CiInt& rhs);
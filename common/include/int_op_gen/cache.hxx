@@ -0,0 +1,330 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef INT_OP_GEN_CACHE
+#define INT_OP_GEN_CACHE
+
+#include <int_op_gen/interface.hxx>
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cingulata
+{
+  /**
+   * @brief      Memoization cache of integer operation results
+   * @details    Results are indexed by the operation name and by the identity
+   *             of input bits: value of plain-text bits and object handle of
+   *             ciphered ones. Cached inputs are stored, but this does not
+   *             keep handles unique with every bit executor: handles of
+   *             #BitTracker do not own their node and node indices restart
+   *             after a reset. Thus the cache must be cleared when the bit
+   *             executor is reset or changed.
+   *
+   *             Cached inputs and results stay allocated while cached, with
+   *             ciphertext bit executors this memory is significant. The
+   *             number of entries is bounded by a capacity, least recently
+   *             used entries are evicted first.
+   */
+  class OpCache {
+  public:
+    using Result = std::vector<CiBitVector>;
+
+    /**
+     * @brief      Default maximal number of entries
+     */
+    static constexpr unsigned DEFAULT_CAPACITY = 1024;
+
+    /**
+     * @brief      Constructs an empty cache
+     *
+     * @param[in]  capacity  maximal number of entries, zero disables caching
+     */
+    OpCache(const unsigned capacity = DEFAULT_CAPACITY)
+        : m_capacity(capacity) {}
+
+    /**
+     * @brief      Get result of operation @c op applied on inputs @c inps. If
+     *             not found, result is computed with @c fnc and stored.
+     *
+     * @param[in]  op    operation name, including scalar parameters
+     * @param[in]  inps  operation inputs
+     * @param[in]  fnc   computes result when not cached
+     *
+     * @return     operation result, valid until next call
+     */
+    const Result& get(const std::string &op, const std::vector<CiBitVector> &inps,
+                      const std::function<Result()> &fnc);
+
+    /**
+     * @brief      Empties the cache
+     */
+    void clear();
+
+    /**
+     * @brief      Sets maximal number of entries, evicts least recently used
+     *             entries in excess
+     */
+    void set_capacity(const unsigned capacity);
+
+    unsigned capacity() const { return m_capacity; }
+
+    /**
+     * @brief      Identity of bit @c bit, the address of its object handle if
+     *             ciphered. Plain-text bits are mapped to the two largest
+     *             values, which are never handle addresses.
+     */
+    static uintptr_t id(const CiBit &bit);
+
+    unsigned size() const { return m_entries.size(); }
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+  private:
+    using Key = std::pair<std::string, std::vector<uintptr_t>>;
+
+    struct KeyHash {
+      size_t operator()(const Key &key) const;
+    };
+
+    struct Entry {
+      std::vector<CiBitVector> inps;
+      Result res;
+      /* position in recency list */
+      std::list<const Key *>::iterator lru;
+    };
+
+    void evict(const unsigned size);
+
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+    /* keys of entries, from most to least recently used */
+    std::list<const Key *> m_lru;
+    unsigned m_capacity;
+    /* result of last call, when not stored */
+    Result m_last;
+    unsigned m_hits = 0;
+    unsigned m_misses = 0;
+  };
+
+  /**
+   * @brief      Integer operations generator with common sub-expression
+   *             elimination
+   * @details    Operations of @c int_op_gen_t are memoized with an #OpCache,
+   *             an operation applied again on the same inputs returns the
+   *             same bits without generating any gate. Derived operations
+   *             (eg. @c greater is @c lower with swapped inputs) and
+   *             operations used internally through the generator interface
+   *             (eg. sort comparisons) are memoized too. Inputs of
+   *             commutative operations are ordered before look-up.
+   *
+   * @tparam     int_op_gen_t  integer operations generator to memoize
+   */
+  template <typename int_op_gen_t>
+  class IntOpGenCache : public int_op_gen_t {
+  public:
+    template <typename... Args>
+    IntOpGenCache(Args &&... args)
+        : int_op_gen_t(std::forward<Args>(args)...) {}
+
+    /**
+     * @brief      Memoization cache
+     */
+    OpCache &cache() const { return m_cache; }
+
+    /**
+     * @brief      Clears the cache, called by #CiContext when the bit
+     *             executor is changed or reset
+     */
+    void reset() override {
+      int_op_gen_t::reset();
+      m_cache.clear();
+    }
+
+    CiBitVector add(const CiBitVector &lhs,
+                    const CiBitVector &rhs) const override {
+      return commutative("add", lhs, rhs, [this](const CiBitVector &a,
+                                                 const CiBitVector &b) {
+        return int_op_gen_t::add(a, b);
+      });
+    }
+
+    CiBitVector sub(const CiBitVector &lhs,
+                    const CiBitVector &rhs) const override {
+      return get("sub", {lhs, rhs},
+                 [&] { return int_op_gen_t::sub(lhs, rhs); });
+    }
+
+    CiBitVector neg(const CiBitVector &lhs) const override {
+      return get("neg", {lhs}, [&] { return int_op_gen_t::neg(lhs); });
+    }
+
+    CiBitVector mul(const CiBitVector &lhs,
+                    const CiBitVector &rhs) const override {
+      return commutative("mul", lhs, rhs, [this](const CiBitVector &a,
+                                                 const CiBitVector &b) {
+        return int_op_gen_t::mul(a, b);
+      });
+    }
+
+    CiBitVector square(const CiBitVector &lhs) const override {
+      return get("square", {lhs}, [&] { return int_op_gen_t::square(lhs); });
+    }
+
+    std::pair<CiBitVector, CiBitVector>
+    divmod(const CiBitVector &lhs, const CiBitVector &rhs) const override {
+      const OpCache::Result &res =
+          m_cache.get("divmod", {lhs, rhs}, [&]() -> OpCache::Result {
+            auto qr = int_op_gen_t::divmod(lhs, rhs);
+            return {qr.first, qr.second};
+          });
+      return {res[0], res[1]};
+    }
+
+    CiBitVector shl(const CiBitVector &lhs, const CiBitVector &amount,
+                    const CiBit &fill = CiBit::zero) const override {
+      return get("shl", {lhs, amount, CiBitVector(1, fill)},
+                 [&] { return int_op_gen_t::shl(lhs, amount, fill); });
+    }
+
+    CiBitVector shr(const CiBitVector &lhs, const CiBitVector &amount,
+                    const CiBit &fill = CiBit::zero) const override {
+      return get("shr", {lhs, amount, CiBitVector(1, fill)},
+                 [&] { return int_op_gen_t::shr(lhs, amount, fill); });
+    }
+
+    CiBitVector rol(const CiBitVector &lhs,
+                    const CiBitVector &amount) const override {
+      return get("rol", {lhs, amount},
+                 [&] { return int_op_gen_t::rol(lhs, amount); });
+    }
+
+    CiBitVector ror(const CiBitVector &lhs,
+                    const CiBitVector &amount) const override {
+      return get("ror", {lhs, amount},
+                 [&] { return int_op_gen_t::ror(lhs, amount); });
+    }
+
+    CiBit equal(const CiBitVector &lhs,
+                const CiBitVector &rhs) const override {
+      return commutative("equal", lhs, rhs, [this](const CiBitVector &a,
+                                                   const CiBitVector &b) {
+        return CiBitVector(1, int_op_gen_t::equal(a, b));
+      })[0];
+    }
+
+    CiBit lower(const CiBitVector &lhs,
+                const CiBitVector &rhs) const override {
+      return get("lower", {lhs, rhs}, [&] {
+        return CiBitVector(1, int_op_gen_t::lower(lhs, rhs));
+      })[0];
+    }
+
+    CiBitVector mux(const CiBitVector &cond,
+                    const std::vector<CiBitVector> &inps) const override {
+      std::vector<CiBitVector> key = inps;
+      key.push_back(cond);
+      return get("mux", key,
+                 [&] { return int_op_gen_t::mux(cond, inps); });
+    }
+
+    CiBitVector lookup(const CiBitVector &idx,
+                       const std::vector<CiBitVector> &table) const override {
+      std::vector<CiBitVector> key = table;
+      key.push_back(idx);
+      return get("lookup", key,
+                 [&] { return int_op_gen_t::lookup(idx, table); });
+    }
+
+    std::vector<CiBitVector> sort(const std::vector<CiBitVector> &v_cbv,
+                                  const std::vector<CiBitVector> &i_cbv,
+                                  const bool reverse) const override {
+      std::vector<CiBitVector> key = v_cbv;
+      key.insert(key.end(), i_cbv.begin(), i_cbv.end());
+      return m_cache.get("sort/" + std::to_string(reverse), key, [&] {
+        return int_op_gen_t::sort(v_cbv, i_cbv, reverse);
+      });
+    }
+
+    std::vector<CiBitVector> top_k(const std::vector<CiBitVector> &v_cbv,
+                                   const std::vector<CiBitVector> &i_cbv,
+                                   const unsigned k,
+                                   const bool reverse) const override {
+      std::vector<CiBitVector> key = v_cbv;
+      key.insert(key.end(), i_cbv.begin(), i_cbv.end());
+      return m_cache.get("top_k/" + std::to_string(k) + "/" +
+                             std::to_string(reverse),
+                         key, [&] {
+                           return int_op_gen_t::top_k(v_cbv, i_cbv, k,
+                                                      reverse);
+                         });
+    }
+
+    CiBitVector sum(const std::vector<CiBitVector> &inps) const override {
+      return get("sum", inps, [&] { return int_op_gen_t::sum(inps); });
+    }
+
+    CiBitVector popcount(const CiBitVector &inp) const override {
+      return get("popcount", {inp},
+                 [&] { return int_op_gen_t::popcount(inp); });
+    }
+
+  private:
+    CiBitVector get(const std::string &op, const std::vector<CiBitVector> &inps,
+                    const std::function<CiBitVector()> &fnc) const {
+      return m_cache.get(op, inps, [&]() -> OpCache::Result {
+        return {fnc()};
+      })[0];
+    }
+
+    /**
+     * Inputs of same bit-size are ordered by their first differing bit
+     * identity, other inputs are not commutative (result bit-size is the
+     * bit-size of @c lhs)
+     */
+    CiBitVector commutative(
+        const std::string &op, const CiBitVector &lhs, const CiBitVector &rhs,
+        const std::function<CiBitVector(const CiBitVector &,
+                                        const CiBitVector &)> &fnc) const {
+      const bool swap = lhs.size() == rhs.size() and less(rhs, lhs);
+      const CiBitVector &a = swap ? rhs : lhs;
+      const CiBitVector &b = swap ? lhs : rhs;
+      return get(op, {a, b}, [&] { return fnc(a, b); });
+    }
+
+    static bool less(const CiBitVector &lhs, const CiBitVector &rhs) {
+      for (unsigned i = 0; i < lhs.size(); ++i) {
+        const uintptr_t l = OpCache::id(lhs[i]);
+        const uintptr_t r = OpCache::id(rhs[i]);
+        if (l != r)
+          return l < r;
+      }
+      return false;
+    }
+
+    mutable OpCache m_cache;
+  };
+} // namespace cingulata
+
+#endif
@@ -23,6 +23,11 @@
 
 #include <int_op_gen/impl/operator.hxx>
 
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 namespace cingulata {
 namespace int_ops {
 
@@ -36,6 +41,14 @@ namespace int_ops {
  *             auctions and computing minima*
  */
 class RippleCarryAdder : public AdderOper {
+public:
+  /**
+   * @brief      Number of AND gates and multiplicative depth of the adder
+   *             for @c size bit inputs and a plain-text carry input
+   */
+  std::pair<unsigned, unsigned> cost(const unsigned size) const;
+
+private:
   /**
    * @brief      Implementations
    * @details    The size of result is the size of @c lhs.
@@ -48,23 +61,46 @@ class RippleCarryAdder : public AdderOper {
   CiBitVector oper(const CiBitVector &lhs, const CiBitVector &rhs,
                    const CiBit &carry_in) const override;
 };
+
 /**
- * @brief      Sklansky adder operator (minimum multiplicative depth)
- * @details    The multiplicative depth of generated circuit is log2(
- * lhs.size())+1 @c It has @c lhs.size()*log(lhs.size()) AND gates and @
- *             4*lhs.size()-1 XOR gates.
- * @note       Circuit described in David Harris.
+ * @brief      Parallel prefix adder operator base class
+ * @details    Carries are computed from bit generate @c g=a&b and propagate
+ *             @c p=a^b signals with a prefix network of operators @c
+ *             (g,p)o(g',p')=(g^(p&g'),p&p'). Group signals are updated in
+ *             place, thus working storage is linear in the input size, and
+ *             group propagate signals are computed only while needed. The
+ *             carry input is merged into the generate signal of the first bit.
+ * @note       Prefix networks described in David Harris.
  *             *A taxonomy of Parallel Prefix Networks*
  */
-class SklanskyAdder : public AdderOper {
+class PrefixAdder : public AdderOper {
+public:
+  /**
+   * @brief      Prefix network on @c n positions, a list of pairs @c (i,j)
+   *             applied in order. Each pair combines the group signals of
+   *             position @c j into position @c i, the group of @c j ends
+   *             right before the group of @c i.
+   *
+   * @param[in]  n     number of positions
+   *
+   * @return     list of combined position pairs
+   */
+  virtual std::vector<std::pair<unsigned, unsigned>>
+  network(const unsigned n) const = 0;
+
+  /**
+   * @brief      Number of AND gates and multiplicative depth of the adder
+   *             for @c size bit inputs and a plain-text carry input
+   */
+  std::pair<unsigned, unsigned> cost(const unsigned size) const;
+
+private:
   /**
    * @brief      Implementations
    * @details    The size of result is the size of @c lhs.
    *
    * @param[in]  lhs   The left hand side
    * @param[in]  rhs   The right hand side
-   * @remark     currently, the implementation does not take into account the @c
-   * carry_in bit
    *
    * @return     sum bit-vector
    */
@@ -72,6 +108,104 @@ class SklanskyAdder : public AdderOper {
                    const CiBit &carry_in) const override;
 };
 
+/**
+ * @brief      Sklansky adder operator (minimum multiplicative depth)
+ * @details    The multiplicative depth of generated circuit is log2(
+ * lhs.size())+1 @c It has @c lhs.size()*log(lhs.size()) AND gates and @
+ *             4*lhs.size()-1 XOR gates.
+ * @note       Circuit described in David Harris.
+ *             *A taxonomy of Parallel Prefix Networks*
+ */
+class SklanskyAdder : public PrefixAdder {
+public:
+  std::vector<std::pair<unsigned, unsigned>>
+  network(const unsigned n) const override;
+};
+
+/**
+ * @brief      Kogge-Stone adder operator
+ * @details    One level shallower than Sklansky adder, log2(lhs.size())
+ *             instead of log2(lhs.size())+1, at the price of far more AND
+ *             gates (631 against 373 for 64-bit inputs). Every node has a
+ *             fanout of 2.
+ */
+class KoggeStoneAdder : public PrefixAdder {
+public:
+  std::vector<std::pair<unsigned, unsigned>>
+  network(const unsigned n) const override;
+};
+
+/**
+ * @brief      Brent-Kung adder operator
+ * @details    The multiplicative depth of generated circuit is about
+ *             2*log2(lhs.size()), it has less than 4*lhs.size() AND gates.
+ */
+class BrentKungAdder : public PrefixAdder {
+public:
+  std::vector<std::pair<unsigned, unsigned>>
+  network(const unsigned n) const override;
+};
+
+/**
+ * @brief      Han-Carlson adder operator
+ * @details    Kogge-Stone network on odd positions followed by a level which
+ *             computes even positions. One level deeper than Kogge-Stone
+ *             adder with about half of its AND gates.
+ */
+class HanCarlsonAdder : public PrefixAdder {
+public:
+  std::vector<std::pair<unsigned, unsigned>>
+  network(const unsigned n) const override;
+};
+
+/**
+ * @brief      Adder selected on each call by a cost model
+ * @details    The cost of an adder for a given input size is @c and_cost
+ *             times its number of AND gates plus @c depth_cost times its
+ *             multiplicative depth. Ripple-carry, Sklansky, Brent-Kung,
+ *             Han-Carlson and Kogge-Stone adders are considered in this
+ *             order, the first one of minimal cost is used.
+ */
+class CostModelAdder : public AdderOper {
+public:
+  /**
+   * @brief      Constructs the object.
+   *
+   * @param[in]  and_cost    Cost of an AND gate
+   * @param[in]  depth_cost  Cost of a multiplicative depth level
+   */
+  CostModelAdder(const unsigned and_cost_p, const unsigned depth_cost_p)
+      : and_cost(and_cost_p), depth_cost(depth_cost_p) {}
+
+  /**
+   * @brief      Copy constructor, the selection cache is copied
+   */
+  CostModelAdder(const CostModelAdder &other);
+
+  /**
+   * @brief      Adder of minimal cost for @c size bit inputs, the choice is
+   *             cached per bit-size. Can be called from several threads.
+   */
+  const AdderOper &select(const unsigned size) const;
+
+private:
+  CiBitVector oper(const CiBitVector &lhs, const CiBitVector &rhs,
+                   const CiBit &carry_in) const override;
+
+  unsigned and_cost;
+  unsigned depth_cost;
+
+  RippleCarryAdder ripple_carry;
+  SklanskyAdder sklansky;
+  BrentKungAdder brent_kung;
+  HanCarlsonAdder han_carlson;
+  KoggeStoneAdder kogge_stone;
+
+  /* selected adder per bit-size, cf. select */
+  mutable std::map<unsigned, int> selected;
+  mutable std::mutex selected_mtx;
+};
+
 } // namespace int_ops
 } // namespace cingulata
 
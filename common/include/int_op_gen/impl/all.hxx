@@ -20,10 +20,15 @@
 
 #include <int_op_gen/impl/adder.hxx>
 #include <int_op_gen/impl/dec.hxx>
+#include <int_op_gen/impl/divider.hxx>
 #include <int_op_gen/impl/equal.hxx>
+#include <int_op_gen/impl/lookup.hxx>
 #include <int_op_gen/impl/lower.hxx>
 #include <int_op_gen/impl/multiplier.hxx>
 #include <int_op_gen/impl/mux.hxx>
 #include <int_op_gen/impl/negate.hxx>
+#include <int_op_gen/impl/popcount.hxx>
+#include <int_op_gen/impl/shift.hxx>
 #include <int_op_gen/impl/sort.hxx>
+#include <int_op_gen/impl/top_k.hxx>
 #include <int_op_gen/impl/multi_inp_adder.hxx>
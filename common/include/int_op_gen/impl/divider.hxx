@@ -0,0 +1,92 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef DIVIDER_OPER
+#define DIVIDER_OPER
+
+#include <functional>
+
+#include <int_op_gen/impl/operator.hxx>
+
+namespace cingulata {
+  namespace int_ops {
+    /**
+     * @brief      Small size restoring divider
+     * @details    Quotient bits are computed from the most significant one.
+     *             At step @c i the partial remainder has @c n-i bits, it is
+     *             compared with the divisor using the borrow of the
+     *             subtraction and the divisor bits above @c n-i. The
+     *             generated circuit has approximatively @c n^2/2 subtractor
+     *             bits and @c n^2/2 multiplexers, its multiplicative depth
+     *             is quadratic in @c n for a ripple-carry subtractor (@c n is
+     *             the input word bit-size).
+     */
+    class DividerSize : public DivOper {
+    public:
+      DividerSize(const std::function<BinaryOper::signature>& sub_p) : sub(sub_p) {}
+
+    private:
+      /**
+       * @brief      Implementation
+       *
+       * @param[in]  lhs   dividend
+       * @param[in]  rhs   divisor
+       *
+       * @return     quotient and remainder
+       */
+      std::pair<CiBitVector, CiBitVector> oper(const CiBitVector& lhs,
+                                               const CiBitVector& rhs) const override;
+
+      std::function<BinaryOper::signature> sub;
+    };
+
+    /**
+     * @brief      Small depth restoring divider
+     * @details    Same algorithm as #DividerSize but the quotient bit of
+     *             each step is given by a logarithmic depth comparator, run
+     *             in parallel with the subtraction, and divisor high bits
+     *             are tested with a parallel prefix OR. The multiplicative
+     *             depth of generated circuit is @c O(n.log2(n)) when
+     *             logarithmic depth subtractor and comparator are used.
+     */
+    class DividerDepth : public DivOper {
+    public:
+      DividerDepth(const std::function<BinaryOper::signature>& sub_p,
+                   const std::function<CompOper::signature>& lower_p)
+          : sub(sub_p), lower(lower_p) {}
+
+    private:
+      /**
+       * @brief      Implementation
+       *
+       * @param[in]  lhs   dividend
+       * @param[in]  rhs   divisor
+       *
+       * @return     quotient and remainder
+       */
+      std::pair<CiBitVector, CiBitVector> oper(const CiBitVector& lhs,
+                                               const CiBitVector& rhs) const override;
+
+      std::function<BinaryOper::signature> sub;
+      std::function<CompOper::signature> lower;
+    };
+  }
+}
+#endif
@@ -0,0 +1,57 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef LOOKUP_OPER
+#define LOOKUP_OPER
+
+#include <int_op_gen/impl/operator.hxx>
+
+namespace cingulata {
+  namespace int_ops {
+    /**
+     * @brief      Table lookup operator (algebraic normal form)
+     * @details    Each output bit is evaluated as its algebraic normal form,
+     *             i.e. a sum of monomials of index bits. Coefficients are
+     *             obtained with the binary Moebius transform of the table,
+     *             which uses XOR gates only. Monomials with a non-zero
+     *             coefficient are generated on demand as a product of a
+     *             monomial of low and of high index bits, and are shared
+     *             between output bits. The multiplicative depth of generated
+     *             circuit is @c ceil(log2(m)), plus one for non plain-text
+     *             tables. It uses less than @c 2^m AND gates for plain-text
+     *             tables (eg. S-boxes) and @c (n+1).2^m for others, where the
+     *             transform also costs @c m.n.2^(m-1) XOR gates. Here @c m is
+     *             the index bit-size and @c n the table element bit-size.
+     */
+    class LookupAnf : public MuxOper {
+      /**
+       * @brief      Implementation
+       *
+       * @param[in]  cond  table index
+       * @param[in]  inps  table elements
+       *
+       * @return     selected element
+       */
+      CiBitVector oper(const CiBitVector& cond,
+                       const std::vector<CiBitVector>& inps) const override;
+    };
+  }
+}
+#endif
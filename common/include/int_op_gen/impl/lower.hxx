@@ -21,23 +21,21 @@
 #ifndef LOWER_OPER
 #define LOWER_OPER
 
-#include <functional>
-
 #include <int_op_gen/impl/operator.hxx>
 
 namespace cingulata {
   namespace int_ops {
     /**
      * @brief      Logarithmic depth lower comparator
-     * @details    The multiplicative depth of generated circuit is logaritmic
-     *             in input size.
+     * @details    The multiplicative depth of generated circuit is @c
+     *             ceil(log2(n))+1. Pairs of (lower, equal) bits are computed
+     *             once for each node of a balanced tree over input bits and
+     *             combined bottom-up, equality bits are only computed where
+     *             needed. It uses less than @c 2.5n AND gates.
      * @note       Circuit described in Garay J, Schoenmakers B, Villegas J.
      *             *Practical and secure solutions for integer comparison*
      */
     class LowerCompDepth : public CompOper {
-    public:
-      LowerCompDepth(const std::function<CompOper::signature>& equal_p) : equal(equal_p) {}
-
     private:
       /**
        * @brief      Implementation
@@ -48,8 +46,6 @@ namespace cingulata {
        * @return     Comparison result
        */
       CiBit oper(const CiBitVector& lhs, const CiBitVector& rhs) const override;
-
-      std::function<CompOper::signature> equal;
     };
 
 
@@ -54,6 +54,113 @@ namespace cingulata
       std::function<BinaryOper::signature> adder;
 
 
+   };
+
+    /**
+     * @brief      Dadda Multiplier implementation
+     * @details    Partial product bits are reduced column by column to the
+     *             Dadda heights sequence (2, 3, 4, 6, 9, ...), using as few
+     *             half and full adders as possible. Partial products equal to
+     *             plain-text zero are skipped and the most significant column
+     *             is summed with XOR gates only, as its carries are dropped.
+     */
+    class DaddaMultiplier : public BinaryOper {
+      public:
+        DaddaMultiplier(const std::function<BinaryOper::signature>& adder_p) : adder(adder_p) {}
+
+      private:
+      /**
+       * @brief      Dadda multiplier
+       *
+       * @details    lhs and rhs have the same length in bits
+       *
+       * @param[in]  lhs   The left hand side
+       * @param[in]  rhs   The right hand side
+       *
+       * @return     Product between inputs, having the same bit length as inputs
+       */
+      CiBitVector oper(const CiBitVector& lhs, const CiBitVector& rhs) const override;
+
+      std::function<BinaryOper::signature> adder;
+   };
+
+    /**
+     * @brief      Karatsuba Multiplier implementation
+     * @details    Inputs are split in halves @c a=a1*2^h+a0 and @c b=b1*2^h+b0.
+     *             The product truncated to @c n bits is the full product
+     *             @c a0*b0 plus the truncated cross products @c a1*b0+a0*b1
+     *             shifted by @c h. Full products are computed recursively
+     *             with 3 half-size multiplications, @c a0*b0, @c a1*b1 and @c
+     *             (a0+a1)*(b0+b1). Inputs smaller than @c min_size are
+     *             multiplied with @c mul.
+     */
+    class KaratsubaMultiplier : public BinaryOper {
+      public:
+        /**
+         * @brief      Constructs the object.
+         *
+         * @param[in]  adder_p     Adder
+         * @param[in]  sub_p       Subtracter
+         * @param[in]  mul_p       Multiplier for small inputs
+         * @param[in]  min_size_p  Smallest input size split in halves
+         */
+        KaratsubaMultiplier(const std::function<BinaryOper::signature>& adder_p,
+                            const std::function<BinaryOper::signature>& sub_p,
+                            const std::function<BinaryOper::signature>& mul_p,
+                            const unsigned min_size_p = 32)
+          : adder(adder_p), sub(sub_p), mul(mul_p), min_size(min_size_p) {}
+
+      private:
+      /**
+       * @brief      Karatsuba multiplier
+       *
+       * @details    lhs and rhs have the same length in bits
+       *
+       * @param[in]  lhs   The left hand side
+       * @param[in]  rhs   The right hand side
+       *
+       * @return     Product between inputs, having the same bit length as inputs
+       */
+      CiBitVector oper(const CiBitVector& lhs, const CiBitVector& rhs) const override;
+
+      /**
+       * @brief      Full product, having twice the bit length of inputs
+       */
+      CiBitVector full(const CiBitVector& lhs, const CiBitVector& rhs) const;
+
+      std::function<BinaryOper::signature> adder;
+      std::function<BinaryOper::signature> sub;
+      std::function<BinaryOper::signature> mul;
+      unsigned min_size;
+   };
+
+    /**
+     * @brief      Multiplication by a plain-text constant
+     * @details    The constant is recoded in canonical signed digit form (no
+     *             two consecutive non-zero digits), thus the product is a sum
+     *             of at most @c n/2+1 shifted copies of the ciphered input,
+     *             some of them negated. Shifted copies are reduced with a
+     *             Wallace tree and a final adder.
+     */
+    class ConstMultiplier : public BinaryOper {
+      public:
+        ConstMultiplier(const std::function<BinaryOper::signature>& adder_p) : adder(adder_p) {}
+
+      private:
+      /**
+       * @brief      Constant multiplier
+       *
+       * @details    lhs and rhs have the same length in bits, all bits of
+       *             @c rhs are plain-text
+       *
+       * @param[in]  lhs   The left hand side
+       * @param[in]  rhs   The plain-text right hand side
+       *
+       * @return     Product between inputs, having the same bit length as inputs
+       */
+      CiBitVector oper(const CiBitVector& lhs, const CiBitVector& rhs) const override;
+
+      std::function<BinaryOper::signature> adder;
    };
   }
 }
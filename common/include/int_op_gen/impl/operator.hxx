@@ -24,6 +24,7 @@
 #include <ci_bit.hxx>
 #include <ci_bit_vector.hxx>
 
+#include <utility>
 #include <vector>
 
 namespace cingulata {
@@ -56,7 +57,13 @@ private:
 };
 
 /**
- * @brief      Binary operator base class
+ * @brief      Adder operator base class
+ * @details    Low bits are summed in clear while the carry is plain-text and
+ *             either both input bits are plain-text or one of them equals
+ *             the carry. High bits which are plain-text zeros in both inputs
+ *             are not given to the implementation, excepting the one
+ *             receiving the carry out. Thus implementations only handle the
+ *             effective ciphered width.
  */
 class AdderOper {
 public:
@@ -86,6 +93,11 @@ private:
 
 /**
  * @brief      Comparison operator base class
+ * @details    Positions with equal plain-text bits in both inputs do not
+ *             change the result of an equality or a lexicographic comparison,
+ *             neither do positions below the most significant one with
+ *             different plain-text bits. These positions are removed before
+ *             calling the implementation.
  */
 class CompOper {
 public:
@@ -111,7 +123,8 @@ public:
    * @details    The number of elements in @c inps must be equal to @c
    *             2^cond.size(). All the elements of @c inps must have the
    *             same bit-size. The bit-size of result is the same as
-   *             bit-size of an @c inps element.
+   *             bit-size of an @c inps element. A plain-text condition
+   *             selects the element without any gate.
    *
    * @param[in]  cond  Selection condition
    * @param[in]  inps  Vector of input words
@@ -178,6 +191,110 @@ private:
                                         const bool reverse) const = 0;
 };
 
+/**
+ * @brief      Top-k selection operator base class
+ */
+class TopKOper {
+public:
+  using signature = std::vector<CiBitVector>(const std::vector<CiBitVector> &,
+                                             const std::vector<CiBitVector> &,
+                                             const unsigned, const bool);
+
+  /**
+   * @brief      Selects elements of @c i_cbv with the @c k smallest keys of
+   *             @c v_cbv (largest if @c reverse is set). The result is the
+   *             same as the first @c k elements of a sort.
+   *
+   * @details    The number of elements in @c v_cbv must be equal to the number
+   *             of elements of @c i_cbv. Keys and elements are resized to the
+   *             largest key and element bit-size respectively. At most @c
+   *             v_cbv.size() elements are returned.
+   *
+   * @param[in]  v_cbv    Vector of CiBitVector (metric to select)
+   * @param[in]  i_cbv    Vector of CiBitVector (metric to retrieve)
+   * @param[in]  k        number of elements to select
+   * @param[in]  reverse  0 if smallest keys, 1 else
+   *
+   * @return     selected elements, in the order of their keys
+   */
+  std::vector<CiBitVector> operator()(const std::vector<CiBitVector> &v_cbv,
+                                      const std::vector<CiBitVector> &i_cbv,
+                                      const unsigned k,
+                                      const bool reverse) const;
+
+private:
+  virtual std::vector<CiBitVector> oper(const std::vector<CiBitVector> &v_cbv,
+                                        const std::vector<CiBitVector> &i_cbv,
+                                        const unsigned k,
+                                        const bool reverse) const = 0;
+};
+
+/**
+ * @brief      Shift/rotate operator base class, the shift amount is a
+ *             bit-vector
+ */
+class ShiftOper {
+public:
+  /**
+   * @brief      Shift direction, left is towards the most significant bits
+   */
+  enum class Mode { SHL, SHR, ROL, ROR };
+
+  using signature = CiBitVector(const CiBitVector &, const CiBitVector &,
+                                const Mode, const CiBit &);
+
+  /**
+   * @brief      Shifts or rotates @c inp by @c amount positions
+   * @details    The amount is an unsigned integer of any bit-size. Shifts
+   *             by @c inp.size() or more positions give a word filled with
+   *             @c fill bits, rotations are done modulo @c inp.size(). The
+   *             bit-size of result is the same as the bit-size of @c inp.
+   *             Plain-text amounts are applied without any gate.
+   *
+   * @param[in]  inp     input word
+   * @param[in]  amount  number of positions
+   * @param[in]  mode    shift or rotate direction
+   * @param[in]  fill    bit inserted by shifts (eg. sign bit for arithmetic
+   *                     right shift), unused by rotations
+   *
+   * @return     shifted word
+   */
+  CiBitVector operator()(const CiBitVector &inp, const CiBitVector &amount,
+                         const Mode mode,
+                         const CiBit &fill = CiBit::zero) const;
+
+private:
+  virtual CiBitVector oper(const CiBitVector &inp, const CiBitVector &amount,
+                           const Mode mode, const CiBit &fill) const = 0;
+};
+
+/**
+ * @brief      Division operator base class
+ */
+class DivOper {
+public:
+  using signature = std::pair<CiBitVector, CiBitVector>(const CiBitVector &,
+                                                        const CiBitVector &);
+
+  /**
+   * @brief      Unsigned integer division of @c lhs by @c rhs
+   * @details    Both inputs must have the same bit-size, which is the
+   *             bit-size of quotient and remainder. Division by zero gives
+   *             an all-ones quotient and remainder @c lhs.
+   *
+   * @param[in]  lhs   dividend
+   * @param[in]  rhs   divisor
+   *
+   * @return     quotient and remainder
+   */
+  std::pair<CiBitVector, CiBitVector> operator()(const CiBitVector &lhs,
+                                                 const CiBitVector &rhs) const;
+
+private:
+  virtual std::pair<CiBitVector, CiBitVector>
+  oper(const CiBitVector &lhs, const CiBitVector &rhs) const = 0;
+};
+
 } // namespace int_ops
 } // namespace cingulata
 #endif
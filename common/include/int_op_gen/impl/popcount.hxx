@@ -0,0 +1,53 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef POPCOUNT_OPER
+#define POPCOUNT_OPER
+
+#include <int_op_gen/impl/operator.hxx>
+
+namespace cingulata {
+  namespace int_ops {
+    /**
+     * @brief      Population count (Hamming weight) operator
+     * @details    Input bits are counted with a tree of full-adders (3:2
+     *             counters) and half-adders, applied column by column starting
+     *             from the least significant one. In each column the
+     *             shallowest bits are added first, larger counters (eg. 7:3,
+     *             15:4) are obtained as trees of full-adders. A full-adder
+     *             uses a single AND gate, thus the generated circuit has about
+     *             @c n AND gates, and its multiplicative depth is about @c
+     *             log2(n) (@c n is the number of input bits). The result has
+     *             the minimal bit-size @c ceil(log2(n+1)). Plain-text bits are
+     *             counted in clear.
+     */
+    class PopCount : public UnaryOper {
+      /**
+       * @brief      Implementation
+       *
+       * @param[in]  inp   input bits
+       *
+       * @return     number of bits set in @c inp
+       */
+      CiBitVector oper(const CiBitVector& inp) const override;
+    };
+  }
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef SHIFT_OPER
+#define SHIFT_OPER
+
+#include <int_op_gen/impl/operator.hxx>
+
+namespace cingulata {
+  namespace int_ops {
+    /**
+     * @brief      Small size barrel shifter
+     * @details    The input word is shifted conditionally by 1, 2, 4, ...
+     *             positions, one stage per amount bit. Shifts by @c n or more
+     *             positions are handled by a single stage. The generated
+     *             circuit has approximatively @c n.log2(n) multiplexers and its
+     *             multiplicative depth is @c log2(n)+1 (@c n is the input word
+     *             bit-size).
+     */
+    class ShiftSize : public ShiftOper {
+      /**
+       * @brief      Implementation
+       *
+       * @param[in]  inp     input word
+       * @param[in]  amount  number of positions
+       * @param[in]  mode    shift or rotate direction
+       * @param[in]  fill    bit inserted by shifts
+       *
+       * @return     shifted word
+       */
+      CiBitVector oper(const CiBitVector& inp, const CiBitVector& amount,
+                       const Mode mode, const CiBit& fill) const override;
+    };
+
+    /**
+     * @brief      Small depth shifter
+     * @details    The @c log2(n) least significant amount bits are decoded
+     *             (#Decoder) and each output bit is the sum of input bits
+     *             selected by the decoded amount. Larger shift amounts are
+     *             detected with a tree of OR gates. The multiplicative depth
+     *             of generated circuit is @c ceil(log2(log2(n)))+2 and it has
+     *             approximatively @c n^2 AND gates (@c n is the input word
+     *             bit-size). Rotations of words whose bit-size is not a power
+     *             of two use additional barrel stages for amount bits above @c
+     *             log2(n).
+     */
+    class ShiftDepth : public ShiftOper {
+      /**
+       * @brief      Implementation
+       *
+       * @param[in]  inp     input word
+       * @param[in]  amount  number of positions
+       * @param[in]  mode    shift or rotate direction
+       * @param[in]  fill    bit inserted by shifts
+       *
+       * @return     shifted word
+       */
+      CiBitVector oper(const CiBitVector& inp, const CiBitVector& amount,
+                       const Mode mode, const CiBit& fill) const override;
+    };
+  }
+}
+#endif
@@ -25,6 +25,7 @@
 
 #include <functional>
 #include <cassert>
+#include <utility>
 
 namespace cingulata
 {
@@ -42,22 +43,56 @@ class SortDepth : public SortOper {
 public:
   SortDepth(const std::function<CompOper::signature> &cmp,
             const std::function<CompOper::signature> &equ,
-            const std::function<BinaryOper::signature> &adder)
-      : cmp(cmp), equ(equ), adder(adder) {}
+            const std::function<UnaryOper::signature> &popcount)
+      : cmp(cmp), equ(equ), popcount(popcount) {}
 
 private:
   std::vector<CiBitVector> oper(const std::vector<CiBitVector> &v_cbv,
                                 const std::vector<CiBitVector> &i_cbv,
                                 const bool reverse) const;
 
-  CiBitVector hammingWeight(const CiBitVector x, unsigned int l,
-                            unsigned int size_ham) const;
-
   std::function<CompOper::signature> cmp;
 
   std::function<CompOper::signature> equ;
 
-  std::function<BinaryOper::signature> adder;
+  std::function<UnaryOper::signature> popcount;
+};
+
+/**
+ * @brief      Sort an array of integers with a sorting network
+ * @details    The network uses @c O(N.log2(N)^2) compare-exchange units, each
+ *             one is a comparator and one AND gate per swapped bit. Networks
+ *             are built for the next power of two and compare-exchange
+ *             units on missing elements are removed. The multiplicative
+ *             depth is @c O(log2(N)^2) times the comparator depth. Elements
+ *             are resized to the largest element bit-size.
+ * @note       Batcher K. *Sorting networks and their applications*
+ */
+class SortSize : public SortOper {
+public:
+  enum class Network {
+    ODD_EVEN_MERGE, ///< Batcher odd-even merge sort, fewer compare-exchanges
+    BITONIC         ///< bitonic sort, regular structure
+  };
+
+  SortSize(const std::function<CompOper::signature> &cmp,
+           const Network network = Network::ODD_EVEN_MERGE)
+      : cmp(cmp), network(network) {}
+
+  /**
+   * @brief      Compare-exchange units of the network for @c n elements,
+   *             pairs @c (i,j) with @c i<j ordered by execution
+   */
+  std::vector<std::pair<unsigned, unsigned>> comparators(const unsigned n) const;
+
+private:
+  std::vector<CiBitVector> oper(const std::vector<CiBitVector> &v_cbv,
+                                const std::vector<CiBitVector> &i_cbv,
+                                const bool reverse) const override;
+
+  std::function<CompOper::signature> cmp;
+
+  Network network;
 };
 }
 }
@@ -0,0 +1,66 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef TOP_K_OPER
+#define TOP_K_OPER
+
+#include <int_op_gen/impl/operator.hxx>
+#include <int_op_gen/impl/sort.hxx>
+
+#include <functional>
+
+namespace cingulata {
+namespace int_ops {
+
+/**
+ * @brief      Select the k smallest (or largest) elements with a tournament
+ * @details    Elements are split in blocks of @c K elements (@c K is @c k
+ *             rounded up to a power of two) sorted with an odd-even merge
+ *             network. Blocks are then merged pairwise along a binary tree,
+ *             the first @c K elements of two sorted blocks are obtained by
+ *             comparing mirrored elements and sorting the resulting bitonic
+ *             sequence. Keys and elements are swapped using the same
+ *             comparison result. The number of comparators is @c
+ *             O(N.log2(K)^2) and the multiplicative depth is @c
+ *             O(log2(N).log2(K)) times the comparator depth. For @c k=1 it is
+ *             a tournament tree with @c N-1 comparators and @c
+ *             ceil(log2(N)) comparator levels. Missing elements have an
+ *             additional plain-text key bit, thus comparisons with them are
+ *             done in clear.
+ */
+class TopK : public TopKOper {
+public:
+  TopK(const std::function<CompOper::signature> &cmp)
+      : cmp(cmp), sorter(cmp) {}
+
+private:
+  std::vector<CiBitVector> oper(const std::vector<CiBitVector> &v_cbv,
+                                const std::vector<CiBitVector> &i_cbv,
+                                const unsigned k,
+                                const bool reverse) const override;
+
+  std::function<CompOper::signature> cmp;
+
+  SortSize sorter;
+};
+
+} // namespace int_ops
+} // namespace cingulata
+#endif
@@ -26,6 +26,7 @@
 #include <ci_int.hxx>
 #include <int_op_gen/impl/all.hxx>
 
+#include <utility>
 #include <vector>
 
 namespace cingulata
@@ -57,6 +58,50 @@ public:
 
   virtual CiBitVector square  ( const CiBitVector& lhs) const;
 
+  /**
+   * @brief      Unsigned integer division. Quotient and remainder have the
+   *             same size as inputs, which must have the same size
+   *
+   * @param[in]  lhs   The dividend
+   * @param[in]  rhs   The divisor
+   *
+   * @return     The quotient and the remainder
+   */
+  virtual std::pair<CiBitVector, CiBitVector>
+                      divmod  ( const CiBitVector& lhs,
+                                const CiBitVector& rhs) const = 0;
+
+  virtual CiBitVector div     ( const CiBitVector& lhs,
+                                const CiBitVector& rhs) const;
+
+  virtual CiBitVector mod     ( const CiBitVector& lhs,
+                                const CiBitVector& rhs) const;
+
+  /**
+   * @brief      Shift integer @c lhs to the most significant bits by an
+   *             unsigned number of positions @c amount. Positions are filled
+   *             with bit @c fill
+   *
+   * @param[in]  lhs     The input bit vector
+   * @param[in]  amount  The number of positions
+   * @param[in]  fill    The inserted bit
+   *
+   * @return     The shifted bit vector
+   */
+  virtual CiBitVector shl     ( const CiBitVector& lhs,
+                                const CiBitVector& amount,
+                                const CiBit& fill = CiBit::zero) const = 0;
+
+  virtual CiBitVector shr     ( const CiBitVector& lhs,
+                                const CiBitVector& amount,
+                                const CiBit& fill = CiBit::zero) const = 0;
+
+  virtual CiBitVector rol     ( const CiBitVector& lhs,
+                                const CiBitVector& amount) const = 0;
+
+  virtual CiBitVector ror     ( const CiBitVector& lhs,
+                                const CiBitVector& amount) const = 0;
+
 
   virtual CiBit equal         ( const CiBitVector& lhs,
                                 const CiBitVector& rhs) const = 0;
@@ -83,17 +128,83 @@ public:
   virtual CiBitVector mux     ( const CiBitVector &cond,
                                 const std::vector<CiBitVector> &inps) const;
 
+  /**
+   * @brief      Returns element @c table[idx], or zero if @c idx is out of
+   *             range. Only the @c ceil(log2(table.size())) low index bits
+   *             select an element, higher ones clear the result. Plain-text
+   *             tables (eg. S-boxes) are evaluated as polynomials in index
+   *             bits, which need less AND gates than #mux, other tables use
+   *             #mux
+   *
+   * @param[in]  idx    The index
+   * @param[in]  table  The table elements
+   *
+   * @return     The selected element
+   */
+  virtual CiBitVector lookup  ( const CiBitVector &idx,
+                                const std::vector<CiBitVector> &table) const;
+
+  /**
+   * @brief      Sorts @c i_cbv elements by keys @c v_cbv, in decreasing order
+   *             if @c reverse is set. Inputs with at most
+   *             #m_sort_depth_max_size elements are sorted with the minimal
+   *             depth sorter, larger ones with a sorting network
+   */
   virtual std::vector<CiBitVector>
                       sort    ( const std::vector<CiBitVector> &v_cbv,
                                 const std::vector<CiBitVector> &i_cbv,
                                 const bool reverse) const;
 
+  /**
+   * @brief      Selects elements of @c i_cbv with the @c k smallest keys in
+   *             @c v_cbv (largest if @c reverse is set), in order. Uses a
+   *             tournament tree, with a linear number of comparators for
+   *             small @c k
+   */
+  virtual std::vector<CiBitVector>
+                      top_k   ( const std::vector<CiBitVector> &v_cbv,
+                                const std::vector<CiBitVector> &i_cbv,
+                                const unsigned k,
+                                const bool reverse) const;
+
   virtual CiBitVector sum     ( const std::vector<CiBitVector> &inps) const;
 
+  /**
+   * @brief      Counts bits set in @c inp. The output has the minimal
+   *             bit-size @c ceil(log2(inp.size()+1))
+   *
+   * @param[in]  inp   The input bit vector
+   *
+   * @return     The Hamming weight of @c inp
+   */
+  virtual CiBitVector popcount( const CiBitVector &inp) const;
+
+  /**
+   * @brief      Discards state which depends on the bit executor, called by
+   *             #CiContext when the bit executor is changed or reset
+   */
+  virtual void        reset   () {}
+
+protected:
+  /**
+   * @brief      Checks if all bits of @c inp are plain-text
+   */
+  static bool is_plain(const CiBitVector &inp);
+
+  /**
+   * Largest number of elements sorted with the minimal depth sorter, which
+   * uses a quadratic number of comparators, zero by default
+   */
+  unsigned                    m_sort_depth_max_size;
+
 private:
   int_ops::MuxDepth           m_mux;
+  int_ops::LookupAnf          m_lookup;
   int_ops::MultiInputAdder    m_multi_input_adder;
+  int_ops::PopCount           m_popcount;
   int_ops::SortDepth          m_sort;
+  int_ops::SortSize           m_sort_size;
+  int_ops::TopK               m_top_k;
 };
 
 } // namespace cingulata
@@ -33,6 +33,9 @@ namespace cingulata
     virtual CiBitVector add     ( const CiBitVector& lhs,
                                   const CiBitVector& rhs) const override;
 
+    virtual CiBitVector sub     ( const CiBitVector& lhs,
+                                  const CiBitVector& rhs) const override;
+
     virtual CiBitVector neg     ( const CiBitVector& lhs) const override;
 
     virtual CiBitVector mul     ( const CiBitVector& lhs,
@@ -44,12 +47,33 @@ namespace cingulata
     virtual CiBit lower         ( const CiBitVector& lhs,
                                   const CiBitVector& rhs) const override;
 
+    virtual std::pair<CiBitVector, CiBitVector>
+                        divmod  ( const CiBitVector& lhs,
+                                  const CiBitVector& rhs) const override;
+
+    virtual CiBitVector shl     ( const CiBitVector& lhs,
+                                  const CiBitVector& amount,
+                                  const CiBit& fill = CiBit::zero) const override;
+
+    virtual CiBitVector shr     ( const CiBitVector& lhs,
+                                  const CiBitVector& amount,
+                                  const CiBit& fill = CiBit::zero) const override;
+
+    virtual CiBitVector rol     ( const CiBitVector& lhs,
+                                  const CiBitVector& amount) const override;
+
+    virtual CiBitVector ror     ( const CiBitVector& lhs,
+                                  const CiBitVector& amount) const override;
+
   private:
-    int_ops::SklanskyAdder      m_add;
+    int_ops::CostModelAdder     m_add;
     int_ops::Negate             m_neg;
     int_ops::WallaceMultiplier  m_mul;
+    int_ops::ConstMultiplier    m_mul_const;
     int_ops::EqualDepth         m_equal;
     int_ops::LowerCompDepth     m_lower;
+    int_ops::ShiftDepth         m_shift;
+    int_ops::DividerDepth       m_div;
   };
 }
 
@@ -47,12 +47,34 @@ namespace cingulata
     virtual CiBit lower         ( const CiBitVector& lhs,
                                   const CiBitVector& rhs) const override;
 
+    virtual std::pair<CiBitVector, CiBitVector>
+                        divmod  ( const CiBitVector& lhs,
+                                  const CiBitVector& rhs) const override;
+
+    virtual CiBitVector shl     ( const CiBitVector& lhs,
+                                  const CiBitVector& amount,
+                                  const CiBit& fill = CiBit::zero) const override;
+
+    virtual CiBitVector shr     ( const CiBitVector& lhs,
+                                  const CiBitVector& amount,
+                                  const CiBit& fill = CiBit::zero) const override;
+
+    virtual CiBitVector rol     ( const CiBitVector& lhs,
+                                  const CiBitVector& amount) const override;
+
+    virtual CiBitVector ror     ( const CiBitVector& lhs,
+                                  const CiBitVector& amount) const override;
+
   private:
-    int_ops::RippleCarryAdder   m_add;
+    int_ops::CostModelAdder     m_add;
     int_ops::Negate             m_neg;
-    int_ops::WallaceMultiplier  m_mul;
+    int_ops::DaddaMultiplier    m_mul;
+    int_ops::KaratsubaMultiplier m_mul_karatsuba;
+    int_ops::ConstMultiplier    m_mul_const;
     int_ops::EqualSize          m_equal;
     int_ops::LowerCompSize      m_lower;
+    int_ops::ShiftSize          m_shift;
+    int_ops::DividerSize        m_div;
   };
 }
 
@@ -0,0 +1,272 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <bit_exec/trace.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace cingulata;
+
+namespace {
+unsigned nr_inps(const Trace::Op op) {
+  switch (op) {
+  case Trace::Op::INPUT:
+  case Trace::Op::ZERO:
+  case Trace::Op::ONE:
+    return 0;
+  case Trace::Op::NOT:
+  case Trace::Op::BUF:
+    return 1;
+  case Trace::Op::MUX:
+    return 3;
+  default:
+    return 2;
+  }
+}
+} // namespace
+
+uint32_t Trace::add_input(const string &name) {
+  uint32_t idx = m_nodes.size();
+  m_nodes.push_back({Op::INPUT, {(uint32_t)m_input_names.size(), 0, 0}});
+  m_nr_uses.push_back(0);
+  m_node_level.push_back(0);
+  m_input_names.push_back(name);
+  return idx;
+}
+
+uint32_t Trace::add_gate(const Op op, const initializer_list<uint32_t> inps) {
+  assert(inps.size() == nr_inps(op));
+
+  uint32_t idx = m_nodes.size();
+  Node node = {op, {0, 0, 0}};
+  uint32_t level = 0;
+  unsigned i = 0;
+  for (uint32_t inp : inps) {
+    assert(inp < idx);
+    node.inps[i++] = inp;
+    m_nr_uses[inp]++;
+    level = max(level, m_node_level[inp]);
+  }
+  m_nodes.push_back(node);
+  m_nr_uses.push_back(0);
+  m_node_level.push_back(level + 1);
+
+  if (m_levels.size() <= level)
+    m_levels.resize(level + 1);
+  m_levels[level].push_back(idx);
+
+  return idx;
+}
+
+void Trace::add_output(const uint32_t node, const string &name) {
+  assert(node < m_nodes.size());
+  m_nr_uses[node]++;
+  m_outputs.push_back(node);
+  m_output_names.push_back(name);
+}
+
+void Trace::clear() {
+  m_nodes.clear();
+  m_nr_uses.clear();
+  m_node_level.clear();
+  m_levels.clear();
+  m_input_names.clear();
+  m_outputs.clear();
+  m_output_names.clear();
+}
+
+ObjHandle Trace::eval(IBitExec &exec, const Node &node,
+                      const vector<ObjHandle> &vals,
+                      const vector<ObjHandle> &inps) const {
+  const uint32_t *in = node.inps;
+  switch (node.op) {
+  case Op::INPUT:
+    return inps[in[0]];
+  case Op::ZERO:
+    return exec.encode(0);
+  case Op::ONE:
+    return exec.encode(1);
+  case Op::NOT:
+    return exec.op_not(vals[in[0]]);
+  case Op::BUF:
+    return vals[in[0]];
+  case Op::AND:
+    return exec.op_and(vals[in[0]], vals[in[1]]);
+  case Op::NAND:
+    return exec.op_nand(vals[in[0]], vals[in[1]]);
+  case Op::ANDNY:
+    return exec.op_andny(vals[in[0]], vals[in[1]]);
+  case Op::ANDYN:
+    return exec.op_andyn(vals[in[0]], vals[in[1]]);
+  case Op::OR:
+    return exec.op_or(vals[in[0]], vals[in[1]]);
+  case Op::NOR:
+    return exec.op_nor(vals[in[0]], vals[in[1]]);
+  case Op::ORNY:
+    return exec.op_orny(vals[in[0]], vals[in[1]]);
+  case Op::ORYN:
+    return exec.op_oryn(vals[in[0]], vals[in[1]]);
+  case Op::XOR:
+    return exec.op_xor(vals[in[0]], vals[in[1]]);
+  case Op::XNOR:
+    return exec.op_xnor(vals[in[0]], vals[in[1]]);
+  case Op::MUX:
+    return exec.op_mux(vals[in[0]], vals[in[1]], vals[in[2]]);
+  }
+  return ObjHandle();
+}
+
+vector<ObjHandle> Trace::replay(IBitExec &exec, const vector<ObjHandle> &inps,
+                                const unsigned nr_threads) const {
+  if (inps.size() != m_input_names.size()) {
+    fprintf(stderr, "Trace::replay -- %lu inputs given, %lu expected\n",
+            inps.size(), m_input_names.size());
+    abort();
+  }
+
+  vector<ObjHandle> vals(m_nodes.size());
+  vector<uint32_t> uses(m_nr_uses);
+
+  /* drop inputs of node @c idx which are not used anymore */
+  auto release = [&](const uint32_t idx) {
+    const Node &node = m_nodes[idx];
+    for (unsigned i = 0; i < nr_inps(node.op); ++i) {
+      if (--uses[node.inps[i]] == 0)
+        vals[node.inps[i]] = ObjHandle();
+    }
+  };
+
+  if (nr_threads <= 1) {
+    for (uint32_t idx = 0; idx < m_nodes.size(); ++idx) {
+      vals[idx] = eval(exec, m_nodes[idx], vals, inps);
+      release(idx);
+    }
+  } else {
+    const uint32_t nr_nodes = m_nodes.size();
+
+    /* consumers of each node, consumers of node i are in
+     * cons[cons_beg[i]..cons_beg[i+1]) */
+    vector<uint32_t> cons_beg(nr_nodes + 1, 0);
+    for (const Node &node : m_nodes)
+      for (unsigned i = 0; i < nr_inps(node.op); ++i)
+        cons_beg[node.inps[i] + 1]++;
+    for (uint32_t idx = 0; idx < nr_nodes; ++idx)
+      cons_beg[idx + 1] += cons_beg[idx];
+    vector<uint32_t> cons(cons_beg.back());
+    vector<uint32_t> cons_end(cons_beg.begin(), cons_beg.end() - 1);
+    for (uint32_t idx = 0; idx < nr_nodes; ++idx) {
+      const Node &node = m_nodes[idx];
+      for (unsigned i = 0; i < nr_inps(node.op); ++i)
+        cons[cons_end[node.inps[i]]++] = idx;
+    }
+
+    /* number of not yet evaluated inputs and of remaining uses of each node */
+    vector<atomic<uint32_t>> pending(nr_nodes);
+    vector<atomic<uint32_t>> uses_left(nr_nodes);
+    deque<uint32_t> ready;
+    for (uint32_t idx = 0; idx < nr_nodes; ++idx) {
+      pending[idx] = nr_inps(m_nodes[idx].op);
+      uses_left[idx] = m_nr_uses[idx];
+      if (pending[idx] == 0)
+        ready.push_back(idx);
+    }
+
+    /* gates are evaluated as soon as all their inputs are available */
+    mutex mtx;
+    condition_variable cv;
+    uint32_t nr_done = 0;
+    auto worker = [&]() {
+      vector<uint32_t> new_ready;
+      unique_lock<mutex> lock(mtx);
+      while (true) {
+        cv.wait(lock, [&] { return not ready.empty() or nr_done == nr_nodes; });
+        if (ready.empty())
+          return;
+        const uint32_t idx = ready.front();
+        ready.pop_front();
+        lock.unlock();
+
+        const Node &node = m_nodes[idx];
+        vals[idx] = eval(exec, node, vals, inps);
+        for (unsigned i = 0; i < nr_inps(node.op); ++i) {
+          if (--uses_left[node.inps[i]] == 0)
+            vals[node.inps[i]] = ObjHandle();
+        }
+        new_ready.clear();
+        for (uint32_t i = cons_beg[idx]; i < cons_beg[idx + 1]; ++i) {
+          if (--pending[cons[i]] == 0)
+            new_ready.push_back(cons[i]);
+        }
+
+        lock.lock();
+        nr_done++;
+        ready.insert(ready.end(), new_ready.begin(), new_ready.end());
+        if (nr_done == nr_nodes or new_ready.size() > 1)
+          cv.notify_all();
+        else if (new_ready.size() == 1)
+          cv.notify_one();
+      }
+    };
+
+    vector<thread> threads;
+    for (unsigned t = 1; t < nr_threads; ++t)
+      threads.emplace_back(worker);
+    worker();
+    for (thread &th : threads)
+      th.join();
+  }
+
+  vector<ObjHandle> outs;
+  outs.reserve(m_outputs.size());
+  for (uint32_t idx : m_outputs)
+    outs.push_back(vals[idx]);
+  return outs;
+}
+
+void Trace::run(IBitExec &exec, const unsigned nr_threads) const {
+  vector<ObjHandle> inps;
+  inps.reserve(m_input_names.size());
+  for (const string &name : m_input_names) {
+    if (name.empty()) {
+      fprintf(stderr, "Trace::run -- anonymous circuit input\n");
+      abort();
+    }
+    inps.push_back(exec.read(name));
+  }
+
+  vector<ObjHandle> outs = replay(exec, inps, nr_threads);
+
+  for (unsigned i = 0; i < outs.size(); ++i) {
+    if (m_output_names[i].empty()) {
+      fprintf(stderr, "Trace::run -- anonymous circuit output\n");
+      abort();
+    }
+    exec.write(outs[i], m_output_names[i]);
+  }
+}
@@ -20,19 +20,14 @@
 
 #include <bit_exec/tracker.hxx>
 
+#include <algorithm>
+#include <cassert>
 #include <fstream>
+#include <unordered_map>
 
 using namespace std;
 using namespace cingulata;
 
-enum class BitTrackerInternal::NodeType : uint8_t {
-  UNKNOWN     = 0,
-  INPUT       = 1<<0,
-  OUTPUT      = 1<<1,
-  LOGIC_GATE  = 1<<2,
-  LIB_GATE    = 1<<3
-};
-
 enum class BitTrackerInternal::GateType : uint8_t {
   UNKNOWN = 0,
   ZERO,
@@ -49,202 +44,616 @@ enum class BitTrackerInternal::GateType : uint8_t {
   ORYN,
   XOR,
   XNOR,
-  MUX
+  MUX,
+  INPUT
+};
+
+namespace {
+using BTI::GateType;
+
+/* gate is not available in library */
+constexpr unsigned NA = 1 << 20;
+
+/**
+ * Gate costs for SHE library, indexed by gate type. A multiplication (AND)
+ * dominates, additions with a ciphertext (XOR) or a plaintext (NOT) are cheap.
+ */
+const unsigned she_gate_cost[] = {
+  NA, //UNKNOWN
+  0, 0, //ZERO, ONE
+  1, 0, //NOT, BUF
+  100, NA, NA, NA, NA, NA, NA, NA, //AND, NAND, ANDNY, ANDYN, OR, NOR, ORNY, ORYN
+  2, NA, //XOR, XNOR
+  NA //MUX
+};
+
+/**
+ * Gate costs for FHE library, indexed by gate type. Each 2-input gate costs a
+ * bootstrapping and a key switching, a multiplexer costs two bootstrappings
+ * and a key switching.
+ */
+const unsigned fhe_gate_cost[] = {
+  NA, //UNKNOWN
+  0, 0, //ZERO, ONE
+  0, 0, //NOT, BUF
+  10, 10, 10, 10, 10, 10, 10, 10, //AND, NAND, ANDNY, ANDYN, OR, NOR, ORNY, ORYN
+  10, 10, //XOR, XNOR
+  17 //MUX
+};
+
+/* node index denoting the absence of node */
+constexpr uint32_t NO_NODE = ~0u;
+
+bool is_2inp(const GateType type) {
+  return type >= GateType::AND and type <= GateType::XNOR;
+}
+
+unsigned nr_inps(const GateType type) {
+  switch (type) {
+    case GateType::NOT:
+    case GateType::BUF:
+      return 1;
+    case GateType::MUX:
+      return 3;
+    default:
+      return is_2inp(type) ? 2 : 0;
+  }
+}
+
+/* BLIF cover of gate type @c type */
+const char* gate_cover_str(const GateType type) {
+  static const char* gate_cover[] = {
+    "UNKNOWN", //UNKNOWN
+    "0", //ZERO
+    "1", //ONE
+    "0 1", //NOT
+    "1 1", //BUF
+    "11 1", //AND
+    "11 0", //NAND
+    "01 1", //ANDNY
+    "10 1", //ANDYN
+    "00 0", //OR
+    "00 1", //NOR
+    "10 0", //ORNY
+    "01 0", //ORYN
+    "01 1\n10 1", //XOR
+    "00 1\n11 1", //XNOR
+    "1-1 1\n01- 1" //MUX
+  };
+  return gate_cover[(uint8_t)type];
+}
+
+/**
+ * Structural hashing key, gate type and identifiers of input nodes
+ */
+struct GateKey {
+  GateType type;
+  uint32_t inps[3];
+
+  bool operator==(const GateKey& other) const {
+    return type == other.type and inps[0] == other.inps[0] and
+           inps[1] == other.inps[1] and inps[2] == other.inps[2];
+  }
+
+  size_t hash() const {
+    size_t h = static_cast<uint8_t>(type);
+    for (uint32_t inp: inps)
+      h = h * 0x9E3779B97F4A7C15ULL + inp;
+    return h ^ (h >> 32);
+  }
 };
 
-class BitTrackerInternal::Node {
-public:
-  Node() {
-    inps.reserve(2);
-  }
-
-  bool is_input() const { return static_cast<uint8_t>(type) & static_cast<uint8_t>(NodeType::INPUT); }
-
-  bool is_logic_gate() const { return static_cast<uint8_t>(type) & static_cast<uint8_t>(NodeType::LOGIC_GATE); }
-
-  bool is_lib_gate() const { return static_cast<uint8_t>(type) & static_cast<uint8_t>(NodeType::LIB_GATE); }
-
-  bool is_output() const { return static_cast<uint8_t>(type) & static_cast<uint8_t>(NodeType::OUTPUT); }
-
-  const char* gate_type_str() const {
-    static const char* GateType2Str[] = {
-      "UNKNOWN",
-      "ZERO","ONE",
-      "NOT","BUF",
-      "AND","NAND","ANDNY","ANDYN","OR","NOR","ORNY","ORYN","XOR","XNOR"};
-    return GateType2Str[(uint8_t)gate_type];
-  }
-
-  const char* gate_cover_str() const {
-    static const char* gate_cover[] = {
-      "UNKNOWN", //UNKNOWN
-      "0", //ZERO
-      "1", //ONE
-      "0 1", //NOT
-      "1 1", //BUF
-      "11 1", //AND
-      "11 0", //NAND
-      "01 1", //ANDNY
-      "10 1", //ANDYN
-      "00 0", //OR
-      "00 1", //NOR
-      "10 0", //ORNY
-      "01 0", //ORYN
-      "01 1\n10 1", //XOR
-      "00 1\n11 1" //XNOR
-    };
-    return gate_cover[(uint8_t)gate_type];
-  }
-
-  void to_blif(ostream& stream) {
-    if (is_logic_gate()) {
-      to_blif_logic(stream);
+/* empty and deleted entries of structural hashing table */
+constexpr uint32_t STRASH_EMPTY = NO_NODE;
+constexpr uint32_t STRASH_DELETED = NO_NODE - 1;
+
+/**
+ * Truth tables of 2-input gates, bit @c (a<<1)|b is the gate output for
+ * inputs @c a and @c b
+ */
+uint8_t gate_tt(const GateType type) {
+  static const uint8_t tt[] = {8, 7, 2, 4, 14, 1, 11, 13, 6, 9};
+  return tt[(uint8_t)type - (uint8_t)GateType::AND];
+}
+
+/* 2-input gate type with truth table @c tt, UNKNOWN for degenerate tables */
+GateType tt_gate(const uint8_t tt) {
+  for (uint8_t t = (uint8_t)GateType::AND; t <= (uint8_t)GateType::XNOR; ++t) {
+    if (gate_tt((GateType)t) == tt)
+      return (GateType)t;
+  }
+  return GateType::UNKNOWN;
+}
+
+/* truth table of gate @c tt with swapped inputs */
+uint8_t tt_swap_inps(const uint8_t tt) {
+  return (tt & 9) | ((tt & 2) << 1) | ((tt & 4) >> 1);
+}
+
+/* truth table of gate @c tt with input @c i negated */
+uint8_t tt_negate_inp(const uint8_t tt, const unsigned i) {
+  const unsigned mask = (i == 0) ? 2 : 1;
+  uint8_t res = 0;
+  for (unsigned idx = 0; idx < 4; ++idx) {
+    if (tt & (1 << (idx ^ mask)))
+      res |= 1 << idx;
+  }
+  return res;
+}
+} // namespace
+
+/**
+ * @brief Node table, a struct of arrays indexed by node
+ * @details Nodes are appended and never removed, except while streaming.
+ *  In streaming mode slots of released nodes are reused, thus nodes are
+ *  identified by an additional unique identifier. Streamed gates store the
+ *  identifiers of their inputs instead of input indices, excepting negations
+ *  which keep (and reference) their input for simplifications.
+ */
+struct BitTrackerInternal::NodeTable {
+  vector<GateType> types;
+  vector<NodeInps> inps;
+
+  /* names of inputs and outputs */
+  unordered_map<uint32_t, string> names;
+
+  /**
+   * Structural hashing table, open addressing with linear probing. Entries
+   * are gate indices, keys are recomputed from the node table.
+   */
+  vector<uint32_t> strash;
+  size_t strash_used = 0;
+
+  /* streaming mode: identifiers, handle reference counts and free slots */
+  bool streaming = false;
+  vector<uint32_t> ids;
+  vector<uint32_t> refs;
+  vector<uint32_t> free_slots;
+  uint32_t id_cnt = 0;
+
+  uint32_t id(const uint32_t n) const {
+    return streaming ? ids[n] : n;
+  }
+
+  const string& name(const uint32_t n) const {
+    static const string empty;
+    auto it = names.find(n);
+    return it == names.end() ? empty : it->second;
+  }
+
+  /* structural hashing key of gate with input indices @c node_inps */
+  GateKey key(const GateType type, const NodeInps& node_inps) const {
+    GateKey key = {type, {0, 0, 0}};
+    for (unsigned i = 0; i < nr_inps(type); ++i)
+      key.inps[i] = id(node_inps[i]);
+    return key;
+  }
+
+  uint32_t new_slot(const GateType type, const NodeInps& node_inps) {
+    if (not free_slots.empty()) {
+      const uint32_t n = free_slots.back();
+      free_slots.pop_back();
+      types[n] = type;
+      inps[n] = node_inps;
+      ids[n] = id_cnt++;
+      refs[n] = 0;
+      return n;
     }
-    else if (is_lib_gate()) {
-      to_blif_lib(stream);
+
+    const uint32_t n = types.size();
+    types.push_back(type);
+    inps.push_back(node_inps);
+    if (streaming) {
+      ids.push_back(id_cnt++);
+      refs.push_back(0);
     }
+    return n;
   }
 
-  NodeType type = NodeType::UNKNOWN;
-  GateType gate_type = GateType::UNKNOWN;
+  /* drops a reference to streamed node @c n */
+  void release(uint32_t n) {
+    while (--refs[n] == 0) {
+      if (types[n] == GateType::INPUT) {
+        names.erase(n);
+      } else {
+        strash_erase(n);
+      }
+      free_slots.push_back(n);
+
+      if (types[n] != GateType::NOT) break;
+      n = inps[n][0];
+    }
+  }
 
-  vector<ObjHandleT<Node>> inps;
+  /* structural hashing key of existing gate @c n */
+  GateKey key(const uint32_t n) const {
+    GateKey key = {types[n], {inps[n][0], inps[n][1], inps[n][2]}};
+    if (streaming and types[n] == GateType::NOT) key.inps[0] = ids[inps[n][0]];
+    return key;
+  }
 
-  string name;
+  /* gate with structural hashing key @c gate_key, NO_NODE if none */
+  uint32_t strash_find(const GateKey& gate_key) const {
+    if (strash.empty()) return NO_NODE;
+    const size_t mask = strash.size() - 1;
+    for (size_t i = gate_key.hash() & mask; strash[i] != STRASH_EMPTY; i = (i + 1) & mask) {
+      const uint32_t n = strash[i];
+      if (n != STRASH_DELETED and types[n] == gate_key.type and key(n) == gate_key) return n;
+    }
+    return NO_NODE;
+  }
 
-private:
-  void to_blif_logic(ostream& stream) {
-    stream << ".names ";
-    for (const auto& inp: inps) {
-      stream << inp->name << " ";
+  void strash_insert(const GateKey& gate_key, const uint32_t n) {
+    if (2 * (strash_used + 1) > strash.size()) {
+      strash_rehash();
+    }
+    const size_t mask = strash.size() - 1;
+    size_t i = gate_key.hash() & mask;
+    while (strash[i] != STRASH_EMPTY and strash[i] != STRASH_DELETED) i = (i + 1) & mask;
+    if (strash[i] == STRASH_EMPTY) strash_used++;
+    strash[i] = n;
+  }
+
+  void strash_erase(const uint32_t n) {
+    if (strash.empty()) return;
+    const size_t mask = strash.size() - 1;
+    for (size_t i = key(n).hash() & mask; strash[i] != STRASH_EMPTY; i = (i + 1) & mask) {
+      if (strash[i] == n) {
+        strash[i] = STRASH_DELETED;
+        return;
+      }
     }
-    stream << name << endl;
-    stream << gate_cover_str() << endl;
-  }
-  void to_blif_lib(ostream& stream) {
-    stream << ".gate " << gate_type_str();
-    char inp_name = 'A';
-    for (const auto& inp: inps) {
-      stream << " " << inp_name << "=" << inp->name;
-      inp_name++;
+  }
+
+  /* resizes table to four times the number of gates it contains */
+  void strash_rehash() {
+    vector<uint32_t> old;
+    old.swap(strash);
+
+    const size_t cnt = count_if(old.begin(), old.end(), [](const uint32_t n) {
+      return n != STRASH_EMPTY and n != STRASH_DELETED;
+    });
+    size_t size = 1024;
+    while (size < 4 * cnt) size *= 2;
+    strash.assign(size, STRASH_EMPTY);
+    strash_used = 0;
+    for (const uint32_t n: old) {
+      if (n != STRASH_EMPTY and n != STRASH_DELETED) strash_insert(key(n), n);
     }
-    stream << " Y=" << name << endl;
   }
+
+  void strash_clear() {
+    vector<uint32_t>().swap(strash);
+    strash_used = 0;
+  }
+
+  /* name of node in streamed circuit */
+  string blif_name(const uint32_t n) const {
+    return types[n] == GateType::INPUT ? name(n) : "n" + to_string(ids[n]);
+  }
+};
+
+/**
+ * @brief State of streaming BLIF export
+ */
+struct BitTrackerInternal::BlifStream {
+  ostream* stream = nullptr;
+  unique_ptr<ofstream> file;
+  unsigned inp_cnt = 0;
+  unsigned out_cnt = 0;
 };
 
+BitTracker::BitTracker() : nodes(make_shared<BTI::NodeTable>()) {}
+
 BitTracker::~BitTracker() {
-  reset();
+  stream_end();
 }
 
 void BitTracker::reset() {
+  stream_end();
+  nodes = make_shared<BTI::NodeTable>();
   inputs.clear();
   outputs.clear();
   gates.clear();
 }
 
-ObjHandle BitTracker::add_gate(BTI::GateType gate_type, const initializer_list<ObjHandleT<BTI::Node>> inps_p) {
-  ObjHandleT<BTI::Node> hdl = mm.new_handle();
-  hdl->type = BTI::NodeType::LOGIC_GATE;
-  hdl->gate_type = gate_type;
-  hdl->inps.assign(inps_p);
-  gates.push_back(hdl);
-  return hdl;
+void BitTracker::stream_blif(ostream& stream, const string& model_name) {
+  reset();
+  nodes->streaming = true;
+  blif_stream.reset(new BTI::BlifStream());
+  blif_stream->stream = &stream;
+
+  stream << "# Circuit created by Cingulata" << endl;
+  stream << ".model " << model_name << endl;
+}
+
+void BitTracker::stream_blif(const string& file_name, const string& model_name) {
+  unique_ptr<ofstream> file(new ofstream(file_name));
+  if (not file->is_open()) {
+    fprintf(stderr, "Error: Unable to open file '%s'\n", file_name.c_str());
+    return;
+  }
+  stream_blif(*file, model_name);
+  blif_stream->file = move(file);
+}
+
+void BitTracker::stream_end() {
+  if (not blif_stream) return;
+  *blif_stream->stream << ".end" << endl;
+  blif_stream.reset();
+  nodes = make_shared<BTI::NodeTable>();
+}
+
+void BitTracker::stream_node(const uint32_t n) {
+  const BTI::NodeTable& tbl = *nodes;
+  const GateType type = tbl.types[n];
+  ostream& stream = *blif_stream->stream;
+  stream << ".names";
+  for (unsigned i = 0; i < nr_inps(type); ++i) {
+    stream << " " << tbl.blif_name(tbl.inps[n][i]);
+  }
+  stream << " " << tbl.blif_name(n) << "\n";
+  stream << gate_cover_str(type) << "\n";
+}
+
+ObjHandle BitTracker::handle(const uint32_t n) {
+  /* offset index so that node 0 is not a null pointer */
+  uintptr_t val = static_cast<uintptr_t>(n) + 1;
+  if (not nodes->streaming) {
+    return ObjHandle(reinterpret_cast<void*>(val), [](void*) {});
+  }
+
+  /* slots of streamed nodes are reused, node identifier in upper bits keeps
+   * handle pointers unique (eg. for decorators keyed on them) */
+  if (sizeof(uintptr_t) > sizeof(uint32_t))
+    val |= static_cast<uintptr_t>(nodes->ids[n]) << 16 << 16;
+  void* ptr = reinterpret_cast<void*>(val);
+
+  nodes->refs[n]++;
+  shared_ptr<BTI::NodeTable> tbl = nodes;
+  return ObjHandle(ptr, [tbl](void* p) {
+    tbl->release(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p) - 1));
+  });
+}
+
+uint32_t BitTracker::node(const ObjHandle& hdl) {
+  return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(hdl.get<void>()) - 1);
+}
+
+uint32_t BitTracker::add_gate(GateType gate_type, const initializer_list<uint32_t> inps_p) {
+  assert(inps_p.size() == nr_inps(gate_type));
+  BTI::NodeInps inps = {0, 0, 0};
+  copy(inps_p.begin(), inps_p.end(), inps.begin());
+
+  /* buffers mark circuit outputs, they are never simplified */
+  if (gate_type == GateType::BUF) {
+    return new_node(gate_type, inps);
+  }
+
+  uint32_t n = simplify(gate_type, inps);
+  if (n != NO_NODE) return n;
+
+  BTI::NodeTable& tbl = *nodes;
+  const GateKey key = tbl.key(gate_type, inps);
+  n = tbl.strash_find(key);
+  if (n != NO_NODE) return n;
+
+  n = new_node(gate_type, inps);
+  tbl.strash_insert(key, n);
+  return n;
+}
+
+uint32_t BitTracker::new_node(const GateType gate_type, const BTI::NodeInps& inps) {
+  BTI::NodeTable& tbl = *nodes;
+  const uint32_t n = tbl.new_slot(gate_type, inps);
+
+  if (blif_stream) {
+    stream_node(n);
+    if (gate_type == GateType::NOT) {
+      tbl.refs[inps[0]]++;
+    } else {
+      for (unsigned i = 0; i < nr_inps(gate_type); ++i)
+        tbl.inps[n][i] = tbl.ids[inps[i]];
+    }
+  } else {
+    gates.push_back(n);
+  }
+  return n;
+}
+
+uint32_t BitTracker::simplify(GateType& gate_type, BTI::NodeInps& inps) {
+  const BTI::NodeTable& tbl = *nodes;
+
+  auto is_gate = [&](const uint32_t n, const GateType type) {
+    return tbl.types[n] == type;
+  };
+  auto is_const = [&](const uint32_t n) {
+    return is_gate(n, GateType::ZERO) or is_gate(n, GateType::ONE);
+  };
+  auto is_not_of = [&](const uint32_t n, const uint32_t other) {
+    return is_gate(n, GateType::NOT) and tbl.inps[n][0] == other;
+  };
+
+  /**
+   * Function of one variable @c x given by its values @c f0 and @c f1. New
+   * constants are not shared as they do not depend on gate inputs.
+   */
+  auto unary = [&](const bool f0, const bool f1, const uint32_t x) {
+    if (f0 == f1) return new_node(f0 ? GateType::ONE : GateType::ZERO, {0, 0, 0});
+    if (f1) return x;
+    return add_gate(GateType::NOT, {x});
+  };
+
+  switch (gate_type) {
+    case GateType::NOT: {
+      const uint32_t x = inps[0];
+      if (is_const(x)) return unary(is_gate(x, GateType::ZERO), is_gate(x, GateType::ZERO), x);
+      if (is_gate(x, GateType::NOT)) return tbl.inps[x][0];
+      break;
+    }
+    case GateType::MUX: {
+      /* mux(c, a, b) = c ? b : a */
+      const uint32_t c = inps[0];
+      const uint32_t a = inps[1];
+      const uint32_t b = inps[2];
+      if (is_gate(c, GateType::ZERO) or a == b) return a;
+      if (is_gate(c, GateType::ONE)) return b;
+      if (is_const(a) and is_const(b)) return unary(is_gate(a, GateType::ONE), is_gate(b, GateType::ONE), c);
+      break;
+    }
+    default:
+      if (is_2inp(gate_type)) {
+        const uint8_t tt = gate_tt(gate_type);
+        auto bit = [&](const unsigned idx) { return (bool)((tt >> idx) & 1); };
+
+        const uint32_t a = inps[0];
+        const uint32_t b = inps[1];
+        if (is_const(a)) {
+          const unsigned va = is_gate(a, GateType::ONE);
+          return unary(bit(va << 1), bit((va << 1) | 1), b);
+        }
+        if (is_const(b)) {
+          const unsigned vb = is_gate(b, GateType::ONE);
+          return unary(bit(vb), bit(2 | vb), a);
+        }
+        if (a == b) return unary(bit(0), bit(3), a);
+        if (is_not_of(a, b)) return unary(bit(2), bit(1), b);
+        if (is_not_of(b, a)) return unary(bit(1), bit(2), a);
+
+        /* normalize input order */
+        if (tbl.id(a) > tbl.id(b)) {
+          gate_type = tt_gate(tt_swap_inps(tt));
+          swap(inps[0], inps[1]);
+        }
+      }
+  }
+
+  return NO_NODE;
 }
 
-ObjHandle BitTracker::add_input(const string& name) {
-  ObjHandleT<BTI::Node> hdl = mm.new_handle();
-  hdl->type = BTI::NodeType::INPUT;
-  hdl->name = name;
-  inputs.push_back(hdl);
-  return hdl;
+uint32_t BitTracker::add_input(const string& name) {
+  BTI::NodeTable& tbl = *nodes;
+  const uint32_t n = tbl.new_slot(GateType::INPUT, {0, 0, 0});
+
+  if (blif_stream) {
+    const string& inp_name = tbl.names[n] =
+      "i:" + (name.empty() ? to_string(blif_stream->inp_cnt++) : name);
+    *blif_stream->stream << ".inputs " << inp_name << "\n";
+  } else {
+    if (not name.empty()) tbl.names[n] = name;
+    inputs.push_back(n);
+  }
+  return n;
 }
 
-void BitTracker::make_output(const ObjHandleT<BTI::Node>& inp, const string& name) {
-  ObjHandleT<BTI::Node> hdl = inp;
-  if (hdl->is_input() or hdl->is_output()) {
-    hdl = (ObjHandleT<BTI::Node>)add_gate(BTI::GateType::BUF, {hdl});
+void BitTracker::make_output(const uint32_t inp, const string& name) {
+  BTI::NodeTable& tbl = *nodes;
+
+  if (blif_stream) {
+    const string out_name = "o:" + (name.empty() ? to_string(blif_stream->out_cnt++) : name);
+    ostream& stream = *blif_stream->stream;
+    stream << ".outputs " << out_name << "\n";
+    stream << ".names " << tbl.blif_name(inp) << " " << out_name << "\n";
+    stream << "1 1\n";
+    return;
+  }
+
+  /* gates in name table are outputs */
+  uint32_t n = inp;
+  if (tbl.types[n] == GateType::INPUT or tbl.names.count(n)) {
+    n = add_gate(GateType::BUF, {n});
   }
-  hdl->type = static_cast<BTI::NodeType>(static_cast<uint8_t>(hdl->type) | static_cast<uint8_t>(BTI::NodeType::OUTPUT));
-  hdl->name = name;
-  outputs.push_back(hdl);
+  tbl.names[n] = name;
+  outputs.push_back(n);
 }
 
 ObjHandle BitTracker::encode(const bit_plain_t pt_val) {
   if (pt_val == 0) {
-    return add_gate(BTI::GateType::ZERO, {});
+    return handle(add_gate(GateType::ZERO, {}));
   } else {
-    return add_gate(BTI::GateType::ONE, {});
+    return handle(add_gate(GateType::ONE, {}));
   }
 }
 
 ObjHandle BitTracker::encrypt(const bit_plain_t pt_val) {
-  return add_input();
+  return handle(add_input());
 }
 
 bit_plain_t BitTracker::decrypt(const ObjHandle& hdl) {
-  make_output(hdl);
+  make_output(node(hdl));
   return 0;
 }
 
 ObjHandle BitTracker::read(const string& name) {
-  return add_input(name);
+  return handle(add_input(name));
 }
 
 void BitTracker::write(const ObjHandle& hdl, const string& name) {
-  make_output(hdl, name);
+  make_output(node(hdl), name);
 }
-
-#define DEFINE_1_INP_OPER(OP_NAME, GATE_TYPE) \
-ObjHandle BitTracker::OP_NAME(const ObjHandle& lhs) { \
-  return add_gate(BTI::GateType::GATE_TYPE, {lhs}); \
+#define DEFINE_1_INP_OPER(CLASS, OP_NAME, GATE_TYPE) \
+ObjHandle CLASS::OP_NAME(const ObjHandle& lhs) { \
+  return handle(add_gate(GateType::GATE_TYPE, {node(lhs)})); \
 }
-#define DEFINE_2_INP_OPER(OP_NAME, GATE_TYPE) \
-ObjHandle BitTracker::OP_NAME(const ObjHandle& lhs, const ObjHandle& rhs) { \
-  return add_gate(BTI::GateType::GATE_TYPE, {lhs, rhs}); \
+#define DEFINE_2_INP_OPER(CLASS, OP_NAME, GATE_TYPE) \
+ObjHandle CLASS::OP_NAME(const ObjHandle& lhs, const ObjHandle& rhs) { \
+  return handle(add_gate(GateType::GATE_TYPE, {node(lhs), node(rhs)})); \
 }
 
-// DEFINE_1_INP_OPER(op_not, NOT);
-DEFINE_2_INP_OPER(op_and, AND);
-DEFINE_2_INP_OPER(op_xor, XOR);
-// DEFINE_2_INP_OPER(op_nand, NAND);
-// DEFINE_2_INP_OPER(op_andyn, ANDYN);
-// DEFINE_2_INP_OPER(op_andny, ANDNY);
-// DEFINE_2_INP_OPER(op_or, OR);
-// DEFINE_2_INP_OPER(op_nor, NOR);
-// DEFINE_2_INP_OPER(op_oryn, ORYN);
-// DEFINE_2_INP_OPER(op_orny, ORNY);
-// DEFINE_2_INP_OPER(op_xnor, XNOR);
-
-// ObjHandle BitTracker::op_mux(const ObjHandle& cond, const ObjHandle& in1, const ObjHandle& in2) {
-//   return add_gate(BTI::GateType::MUX, {cond, in1, in2});
-// }
+DEFINE_2_INP_OPER(BitTracker, op_and, AND);
+DEFINE_2_INP_OPER(BitTracker, op_xor, XOR);
+
+DEFINE_1_INP_OPER(BitTrackerFHE, op_not, NOT);
+DEFINE_2_INP_OPER(BitTrackerFHE, op_nand, NAND);
+DEFINE_2_INP_OPER(BitTrackerFHE, op_andyn, ANDYN);
+DEFINE_2_INP_OPER(BitTrackerFHE, op_andny, ANDNY);
+DEFINE_2_INP_OPER(BitTrackerFHE, op_or, OR);
+DEFINE_2_INP_OPER(BitTrackerFHE, op_nor, NOR);
+DEFINE_2_INP_OPER(BitTrackerFHE, op_oryn, ORYN);
+DEFINE_2_INP_OPER(BitTrackerFHE, op_orny, ORNY);
+DEFINE_2_INP_OPER(BitTrackerFHE, op_xnor, XNOR);
+
+ObjHandle BitTrackerFHE::op_mux(const ObjHandle& cond, const ObjHandle& in1, const ObjHandle& in2) {
+  return handle(add_gate(GateType::MUX, {node(cond), node(in1), node(in2)}));
+}
 
 void BitTracker::export_blif(ostream& stream, const string& model_name) {
+  const BTI::NodeTable& tbl = *nodes;
+
   stream << "# Circuit created by Cingulata" << endl;
   stream << ".model " << model_name << endl;
 
+  /* names of inputs and outputs, gates are named after their index */
+  unordered_map<uint32_t, string> io_names;
+  auto name = [&](const uint32_t n) {
+    auto it = io_names.find(n);
+    return it == io_names.end() ? "n" + to_string(n) : it->second;
+  };
+
   stream << ".inputs ";
   uint cnt = 0;
-  for (ObjHandleT<BTI::Node>& node: inputs) {
-    if (node->name.empty()) node->name = to_string(cnt++);
-    node->name = "i:" + node->name;
-    stream << node->name << " ";
+  for (const uint32_t n: inputs) {
+    const string& inp_name = tbl.name(n);
+    stream << (io_names[n] = "i:" + (inp_name.empty() ? to_string(cnt++) : inp_name)) << " ";
   }
   stream << endl;
 
   stream << ".outputs ";
   cnt = 0;
-  for (ObjHandleT<BTI::Node>& node: outputs) {
-    if (node->name.empty()) node->name = to_string(cnt++);
-    node->name = "o:" + node->name;
-    stream << node->name << " ";
+  for (const uint32_t n: outputs) {
+    const string& out_name = tbl.name(n);
+    stream << (io_names[n] = "o:" + (out_name.empty() ? to_string(cnt++) : out_name)) << " ";
   }
   stream << endl;
 
-  cnt = 0;
-  for (ObjHandleT<BTI::Node>& node: gates) {
-    if (node->name.empty()) node->name = "n" + to_string(cnt++);
-    node->to_blif(stream);
+  for (const uint32_t n: gates) {
+    const GateType type = tbl.types[n];
+    stream << ".names ";
+    for (unsigned i = 0; i < nr_inps(type); ++i) {
+      stream << name(tbl.inps[n][i]) << " ";
+    }
+    stream << name(n) << "\n";
+    stream << gate_cover_str(type) << "\n";
   }
 
   stream << ".end" << endl;
@@ -259,3 +668,243 @@ void BitTracker::export_blif(const string& file_name,
     fprintf(stderr, "Error: Unable to open file '%s'\n", file_name.c_str());
   }
 }
+
+Trace BitTracker::export_trace() const {
+  static const Trace::Op GateType2Op[] = {
+    Trace::Op::BUF, // UNKNOWN
+    Trace::Op::ZERO, Trace::Op::ONE,
+    Trace::Op::NOT, Trace::Op::BUF,
+    Trace::Op::AND, Trace::Op::NAND, Trace::Op::ANDNY, Trace::Op::ANDYN,
+    Trace::Op::OR, Trace::Op::NOR, Trace::Op::ORNY, Trace::Op::ORYN,
+    Trace::Op::XOR, Trace::Op::XNOR, Trace::Op::MUX};
+
+  const BTI::NodeTable& tbl = *nodes;
+  Trace trace;
+  vector<uint32_t> ids(tbl.types.size());
+
+  for (const uint32_t n: inputs) {
+    ids[n] = trace.add_input(tbl.name(n));
+  }
+
+  for (const uint32_t n: gates) {
+    const GateType type = tbl.types[n];
+    assert(type != GateType::UNKNOWN);
+    const Trace::Op op = GateType2Op[(uint8_t)type];
+    const BTI::NodeInps& inps = tbl.inps[n];
+    switch (nr_inps(type)) {
+      case 0:
+        ids[n] = trace.add_gate(op, {});
+        break;
+      case 1:
+        ids[n] = trace.add_gate(op, {ids[inps[0]]});
+        break;
+      case 2:
+        ids[n] = trace.add_gate(op, {ids[inps[0]], ids[inps[1]]});
+        break;
+      default:
+        ids[n] = trace.add_gate(op, {ids[inps[0]], ids[inps[1]], ids[inps[2]]});
+    }
+  }
+
+  for (const uint32_t n: outputs) {
+    trace.add_output(ids[n], tbl.name(n));
+  }
+
+  return trace;
+}
+
+void BitTracker::lower(const GateLib lib) {
+  using BTI::NodeInps;
+  BTI::NodeTable& tbl = *nodes;
+
+  const unsigned* cost = (lib == GateLib::SHE) ? she_gate_cost : fhe_gate_cost;
+  auto gate_cost = [&](const GateType type) { return cost[(uint8_t)type]; };
+
+  /* number of gates using each node, outputs count as users */
+  vector<unsigned> uses(tbl.types.size(), 0);
+  for (const uint32_t n: gates) {
+    for (unsigned i = 0; i < nr_inps(tbl.types[n]); ++i) uses[tbl.inps[n][i]]++;
+  }
+  for (const uint32_t n: outputs) uses[n]++;
+
+  vector<uint32_t> lowered;
+  lowered.reserve(gates.size());
+
+  auto is_gate = [&](const uint32_t n, const GateType type) {
+    return tbl.types[n] == type;
+  };
+
+  auto single_use = [&](const uint32_t n) {
+    return not is_gate(n, GateType::INPUT) and uses[n] == 1;
+  };
+
+  auto set_gate = [&](const uint32_t n, const GateType type, const NodeInps inps) {
+    for (unsigned i = 0; i < nr_inps(type); ++i) uses[inps[i]]++;
+    for (unsigned i = 0; i < nr_inps(tbl.types[n]); ++i) uses[tbl.inps[n][i]]--;
+    tbl.types[n] = type;
+    tbl.inps[n] = inps;
+  };
+
+  auto new_gate = [&](const GateType type, const NodeInps inps) {
+    const uint32_t n = tbl.new_slot(GateType::UNKNOWN, {0, 0, 0});
+    uses.push_back(0);
+    set_gate(n, type, inps);
+    lowered.push_back(n);
+    return n;
+  };
+
+  /* node @c inp or its negation */
+  auto literal = [&](const uint32_t inp, const bool negate) {
+    return negate ? new_gate(GateType::NOT, {inp, 0, 0}) : inp;
+  };
+
+  /* decompose gate @c n into gates available in library */
+  auto decompose = [&](const uint32_t n) {
+    const NodeInps inps = tbl.inps[n];
+    const uint32_t a = inps[0];
+    const uint32_t b = inps[1];
+
+    if (is_gate(n, GateType::MUX)) {
+      /* mux(c, in1, in2) = c ? in2 : in1 = in1 ^ (c & (in1 ^ in2)) */
+      const uint32_t c = inps[0];
+      const uint32_t x = new_gate(GateType::XOR, {inps[1], inps[2], 0});
+      const uint32_t y = new_gate(GateType::AND, {c, x, 0});
+      set_gate(n, GateType::XOR, {inps[1], y, 0});
+      return;
+    }
+
+    assert(is_2inp(tbl.types[n]));
+    const uint8_t tt = gate_tt(tbl.types[n]);
+    const unsigned ones = __builtin_popcount(tt);
+
+    if (ones == 2) {
+      /* XNOR gate */
+      const uint32_t x = new_gate(GateType::XOR, {a, b, 0});
+      set_gate(n, GateType::NOT, {x, 0, 0});
+      return;
+    }
+
+    /* input values for which the gate output differs from the others */
+    unsigned pos = 0;
+    while (((tt >> pos) & 1) != (ones == 1)) pos++;
+    const bool va = pos >> 1, vb = pos & 1;
+    const bool neg_out = (ones == 3);
+
+    /* (a == va) & (b == vb), negated if needed */
+    const unsigned and_cost = gate_cost(GateType::AND) +
+      (!va + !vb + neg_out) * gate_cost(GateType::NOT);
+    /* x | y = x ^ y ^ (x & y) with x = (a != va) and y = (b != vb) */
+    const unsigned xor_cost = neg_out ? 2 * gate_cost(GateType::XOR) +
+      gate_cost(GateType::AND) + (va + vb) * gate_cost(GateType::NOT) : NA;
+
+    if (and_cost <= xor_cost) {
+      const uint32_t x = literal(a, !va);
+      const uint32_t y = literal(b, !vb);
+      if (neg_out) {
+        const uint32_t z = new_gate(GateType::AND, {x, y, 0});
+        set_gate(n, GateType::NOT, {z, 0, 0});
+      } else {
+        set_gate(n, GateType::AND, {x, y, 0});
+      }
+    } else {
+      const uint32_t x = literal(a, va);
+      const uint32_t y = literal(b, vb);
+      const uint32_t z1 = new_gate(GateType::XOR, {x, y, 0});
+      const uint32_t z2 = new_gate(GateType::AND, {x, y, 0});
+      set_gate(n, GateType::XOR, {z1, z2, 0});
+    }
+  };
+
+  for (const uint32_t n: gates) {
+    GateType type = tbl.types[n];
+
+    /* replace XOR with constant one by a negation */
+    if (type == GateType::XOR) {
+      for (unsigned i = 0; i < 2; ++i) {
+        if (is_gate(tbl.inps[n][i], GateType::ONE) and
+            gate_cost(GateType::NOT) < gate_cost(GateType::XOR)) {
+          set_gate(n, GateType::NOT, {tbl.inps[n][1 - i], 0, 0});
+          type = GateType::NOT;
+          break;
+        }
+      }
+    }
+
+    /* absorb negated inputs */
+    if (is_2inp(type)) {
+      for (unsigned i = 0; i < 2; ++i) {
+        const uint32_t inp = tbl.inps[n][i];
+        if (not is_gate(inp, GateType::NOT)) continue;
+
+        const GateType new_type = tt_gate(tt_negate_inp(gate_tt(type), i));
+        if (gate_cost(new_type) <= gate_cost(type)) {
+          NodeInps inps = tbl.inps[n];
+          inps[i] = tbl.inps[inp][0];
+          set_gate(n, new_type, inps);
+          type = new_type;
+        }
+      }
+    }
+
+    /* fuse negation with its input gate */
+    if (type == GateType::NOT) {
+      const uint32_t inp = tbl.inps[n][0];
+      if (is_gate(inp, GateType::NOT)) {
+        set_gate(n, GateType::BUF, {tbl.inps[inp][0], 0, 0});
+        type = GateType::BUF;
+      } else if (single_use(inp) and is_2inp(tbl.types[inp])) {
+        const GateType new_type = tt_gate(~gate_tt(tbl.types[inp]) & 0xF);
+        if (gate_cost(new_type) <= gate_cost(tbl.types[inp]) + gate_cost(type)) {
+          set_gate(n, new_type, tbl.inps[inp]);
+          type = new_type;
+        }
+      }
+    }
+
+    /* fuse b ^ (c & (a ^ b)) into a multiplexer mux(c, b, a) */
+    if (type == GateType::XOR and gate_cost(GateType::MUX) <
+        2 * gate_cost(GateType::XOR) + gate_cost(GateType::AND)) {
+      for (unsigned i = 0; i < 2 and type == GateType::XOR; ++i) {
+        const uint32_t b = tbl.inps[n][i];
+        const uint32_t y = tbl.inps[n][1 - i];
+        if (not is_gate(y, GateType::AND) or not single_use(y)) continue;
+
+        for (unsigned j = 0; j < 2; ++j) {
+          const uint32_t c = tbl.inps[y][j];
+          const uint32_t x = tbl.inps[y][1 - j];
+          if (not is_gate(x, GateType::XOR) or not single_use(x)) continue;
+
+          uint32_t a;
+          if (tbl.inps[x][0] == b) a = tbl.inps[x][1];
+          else if (tbl.inps[x][1] == b) a = tbl.inps[x][0];
+          else continue;
+
+          set_gate(n, GateType::MUX, {c, b, a});
+          type = GateType::MUX;
+          break;
+        }
+      }
+    }
+
+    if (gate_cost(type) >= NA) {
+      decompose(n);
+    }
+
+    lowered.push_back(n);
+  }
+
+  /* remove unused gates, in reverse topological order */
+  gates.clear();
+  for (auto it = lowered.rbegin(); it != lowered.rend(); ++it) {
+    const uint32_t n = *it;
+    if (uses[n] == 0) {
+      for (unsigned i = 0; i < nr_inps(tbl.types[n]); ++i) uses[tbl.inps[n][i]]--;
+    } else {
+      gates.push_back(n);
+    }
+  }
+  reverse(gates.begin(), gates.end());
+
+  /* rewritten gates cannot be shared anymore */
+  tbl.strash_clear();
+}
@@ -115,6 +115,10 @@ bool CiBit::is_plain() const {
   return obj_hdl.is_empty();
 }
 
+const ObjHandle& CiBit::get_obj_handle() const {
+  return obj_hdl;
+}
+
 CiBit& CiBit::op_not() {
   if (is_plain())
     pt_val = negate(pt_val);
@@ -24,6 +24,8 @@
 #include <ci_fncs.hxx>
 #include <ci_int.hxx>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace cingulata {
@@ -33,10 +35,6 @@ namespace
   template<typename out_t, typename inp_t>
   out_t cast(const inp_t& val);
 
-  template<> CiBitVector cast<CiBitVector, CiBit>(const CiBit& val) {
-    return CiBitVector(1, val);
-  }
-
   template<> CiBitVector cast<CiBitVector, CiInt>(const CiInt& val) {
     return val.cast();
   }
@@ -52,6 +50,51 @@ namespace
       out_vals.push_back(cast<out_t, inp_t>(val));
     return out_vals;
   }
+
+  /**
+   * Casts integers to the largest bit-size, @c is_signed is set if all of
+   * them are signed
+   */
+  vector<CiBitVector> common_cast(const vector<CiInt>& vals, bool& is_signed) {
+    unsigned size = 0;
+    is_signed = true;
+    for (const CiInt& val: vals) {
+      size = std::max(size, val.size());
+      is_signed = is_signed and val.is_signed();
+    }
+
+    vector<CiBitVector> out_vals;
+    for (const CiInt& val: vals)
+      out_vals.push_back(val.cast(size));
+    return out_vals;
+  }
+
+  /**
+   * Flips sign bits, thus unsigned comparison gives the signed order
+   */
+  void flip_sign(vector<CiBitVector>& vals) {
+    for (CiBitVector& val: vals)
+      if (val.size() > 0)
+        val[val.size()-1] = ~val[val.size()-1];
+  }
+
+  vector<CiInt> to_ints(const vector<CiBitVector>& vals, const bool is_signed) {
+    vector<CiInt> out_vals;
+    for (const CiBitVector& val: vals)
+      out_vals.emplace_back(val, is_signed);
+    return out_vals;
+  }
+
+  vector<CiInt> indices(const unsigned n) {
+    unsigned size = 1;
+    while ((1UL << size) < n)
+      size++;
+
+    vector<CiInt> out_vals;
+    for (unsigned i = 0; i < n; ++i)
+      out_vals.emplace_back(CiBitVector(encode_plain_int(i, size)), false);
+    return out_vals;
+  }
 }
 
 
@@ -60,14 +103,35 @@ CiInt select(const CiBit &cond, const CiInt &a, const CiInt &b) {
   return CiInt(bv, result_is_signed(a, b));
 }
 
+CiInt lookup(const CiInt &idx, const vector<CiInt> &table) {
+  unsigned size = 0;
+  bool is_signed = true;
+  for (const CiInt &elem : table) {
+    size = std::max(size, elem.size());
+    is_signed = is_signed and elem.is_signed();
+  }
+
+  vector<CiBitVector> m_table;
+  for (const CiInt &elem : table)
+    m_table.push_back(elem.cast(size));
+
+  const auto &bv = CiContext::get_int_op_gen()->lookup(idx.cast(), m_table);
+  return CiInt(bv, is_signed);
+}
+
 CiInt sum(const vector<CiInt> &vals) {
   const auto m_vals = vcast<CiBitVector>(vals);
   return CiContext::get_int_op_gen()->sum(m_vals);
 }
 
 CiInt sum(const vector<CiBit> &vals) {
-  const auto m_vals = vcast<CiBitVector>(vals);
-  return CiContext::get_int_op_gen()->sum(m_vals);
+  if (vals.empty())
+    return CiInt(CiBitVector(), false);
+  return CiContext::get_int_op_gen()->popcount(CiBitVector(vals));
+}
+
+CiInt popcount(const CiInt &val) {
+  return CiInt(CiContext::get_int_op_gen()->popcount(val.cast()), false);
 }
 
 vector<CiInt> sort(const vector<CiInt> &vals, const bool reverse) {
@@ -97,6 +161,45 @@ vector<CiInt> argsort(const vector<CiInt> &vals,
   return vcast<CiInt>(res);
 }
 
+CiInt min(const vector<CiInt> &vals) {
+  return top_k(vals, 1, false)[0];
+}
+
+CiInt max(const vector<CiInt> &vals) {
+  return top_k(vals, 1, true)[0];
+}
 
+CiInt argmin(const vector<CiInt> &vals) {
+  return top_k(vals, indices(vals.size()), 1, false)[0];
+}
+
+CiInt argmax(const vector<CiInt> &vals) {
+  return top_k(vals, indices(vals.size()), 1, true)[0];
+}
+
+vector<CiInt> top_k(const vector<CiInt> &vals, const unsigned k,
+                    const bool reverse) {
+  bool is_signed;
+  vector<CiBitVector> m_vals = common_cast(vals, is_signed);
+  if (is_signed)
+    flip_sign(m_vals);
+
+  vector<CiBitVector> res = CiContext::get_int_op_gen()->top_k(m_vals, m_vals, k, reverse);
+  if (is_signed)
+    flip_sign(res);
+  return to_ints(res, is_signed);
+}
+
+vector<CiInt> top_k(const vector<CiInt> &vals, const vector<CiInt> &elems,
+                    const unsigned k, const bool reverse) {
+  bool is_signed, elems_is_signed;
+  vector<CiBitVector> m_vals = common_cast(vals, is_signed);
+  if (is_signed)
+    flip_sign(m_vals);
+  const vector<CiBitVector> m_elems = common_cast(elems, elems_is_signed);
+
+  const vector<CiBitVector> res = CiContext::get_int_op_gen()->top_k(m_vals, m_elems, k, reverse);
+  return to_ints(res, elems_is_signed);
+}
 
 }
@@ -180,6 +180,16 @@ CiInt& CiInt::operator*=(const CiInt& other) {
   return *this;
 }
 
+CiInt& CiInt::operator/=(const CiInt& other) {
+  *this = *this / other;
+  return *this;
+}
+
+CiInt& CiInt::operator%=(const CiInt& other) {
+  *this = *this % other;
+  return *this;
+}
+
 CiInt& CiInt::operator&=(const CiInt& other) {
   m_bits.op_and(other.m_bits, other.sign());
   return *this;
@@ -336,8 +346,47 @@ CiInt cingulata::operator*(const CiInt& lhs, const CiInt& rhs) {
   }
 }
 
-// CiInt CiInt::operator/(const CiInt& lhs, const CiInt& rhs);
-// CiInt CiInt::operator%(const CiInt& lhs, const CiInt& rhs);
+namespace {
+/**
+ * @brief      Quotient and remainder of integer division
+ * @details    Signed division is done on absolute values, quotient is
+ *             negated when operand signs differ and remainder takes the sign
+ *             of @c lhs.
+ */
+pair<CiInt, CiInt> divmod(const CiInt& lhs, const CiInt& rhs) {
+  unsigned res_size = result_size(lhs, rhs);
+  bool res_is_signed = result_is_signed(lhs, rhs);
+  auto op_gen = CiContext::get_int_op_gen();
+
+  CiBitVector a = lhs.cast(res_size);
+  CiBitVector b = rhs.cast(res_size);
+  if (not res_is_signed) {
+    auto res = op_gen->divmod(a, b);
+    return {CiInt(res.first, false), CiInt(res.second, false)};
+  }
+
+  const CiBit sa = a[-1];
+  const CiBit sb = b[-1];
+  a = op_gen->mux(sa, a, op_gen->neg(a));
+  b = op_gen->mux(sb, b, op_gen->neg(b));
+  auto res = op_gen->divmod(a, b);
+  CiBitVector quo = op_gen->mux(sa ^ sb, res.first, op_gen->neg(res.first));
+  CiBitVector rem = op_gen->mux(sa, res.second, op_gen->neg(res.second));
+  return {CiInt(quo, true), CiInt(rem, true)};
+}
+} // namespace
+
+CiInt cingulata::operator/(const CiInt& lhs, const CiInt& rhs) {
+  return divmod(lhs, rhs).first;
+}
+
+CiInt cingulata::operator%(const CiInt& lhs, const CiInt& rhs) {
+  if (&lhs == &rhs) {
+     /** < when @c lhs and @c rhs are the same the remainder is zero */
+    return CiInt(CiBit::zero, lhs.size(), lhs.is_signed());
+  }
+  return divmod(lhs, rhs).second;
+}
 
 /* Bitwise logic */
 CiInt cingulata::operator~(const CiInt& lhs) {
@@ -378,6 +427,27 @@ CiInt cingulata::ror(CiInt lhs, const int pos) {
   return lhs.ror(pos);
 }
 
+CiInt cingulata::operator<<(const CiInt& lhs, const CiInt& pos) {
+  return CiInt(CiContext::get_int_op_gen()->shl(lhs.cast(), pos.cast()),
+               lhs.is_signed());
+}
+
+CiInt cingulata::operator>>(const CiInt& lhs, const CiInt& pos) {
+  return CiInt(
+      CiContext::get_int_op_gen()->shr(lhs.cast(), pos.cast(), lhs.sign()),
+      lhs.is_signed());
+}
+
+CiInt cingulata::rol(const CiInt& lhs, const CiInt& pos) {
+  return CiInt(CiContext::get_int_op_gen()->rol(lhs.cast(), pos.cast()),
+               lhs.is_signed());
+}
+
+CiInt cingulata::ror(const CiInt& lhs, const CiInt& pos) {
+  return CiInt(CiContext::get_int_op_gen()->ror(lhs.cast(), pos.cast()),
+               lhs.is_signed());
+}
+
 /* Equal/not-equal operators */
 #define DEFINE_RELATIONAL_OPERATOR_1(OP_NAME, OP_FUNC, SAME_OPERANDS_CODE)     \
   CiBit cingulata::OP_NAME(const CiInt &lhs, const CiInt &rhs) {               \
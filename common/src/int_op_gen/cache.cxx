@@ -0,0 +1,93 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <int_op_gen/cache.hxx>
+
+using namespace std;
+using namespace cingulata;
+
+uintptr_t OpCache::id(const CiBit &bit) {
+  if (bit.is_plain())
+    return UINTPTR_MAX - bit.get_val();
+  return reinterpret_cast<uintptr_t>(bit.get_obj_handle().get<void>());
+}
+
+size_t OpCache::KeyHash::operator()(const Key &key) const {
+  size_t h = hash<string>()(key.first);
+  for (const uintptr_t v : key.second)
+    h ^= hash<uintptr_t>()(v) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h;
+}
+
+const OpCache::Result &OpCache::get(const string &op,
+                                    const vector<CiBitVector> &inps,
+                                    const function<Result()> &fnc) {
+  /* input bit-sizes make the key unambiguous */
+  Key key{op, {}};
+  for (const CiBitVector &inp : inps) {
+    key.second.push_back(inp.size());
+    for (unsigned i = 0; i < inp.size(); ++i)
+      key.second.push_back(id(inp[i]));
+  }
+
+  auto it = m_entries.find(key);
+  if (it != m_entries.end()) {
+    m_hits++;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+    return it->second.res;
+  }
+
+  m_misses++;
+  Result res = fnc();
+  if (m_capacity == 0) {
+    m_last = move(res);
+    return m_last;
+  }
+
+  evict(m_capacity - 1);
+  const auto ins = m_entries.emplace(move(key), Entry{inps, move(res), {}});
+  it = ins.first;
+  /* not inserted if fnc already stored the same operation */
+  if (ins.second) {
+    m_lru.push_front(&it->first);
+    it->second.lru = m_lru.begin();
+  }
+  return it->second.res;
+}
+
+void OpCache::evict(const unsigned size) {
+  while (m_entries.size() > size) {
+    m_entries.erase(*m_lru.back());
+    m_lru.pop_back();
+  }
+}
+
+void OpCache::clear() {
+  m_entries.clear();
+  m_lru.clear();
+  m_last.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
+
+void OpCache::set_capacity(const unsigned capacity) {
+  m_capacity = capacity;
+  evict(capacity);
+}
@@ -20,10 +20,9 @@
 
 #include <int_op_gen/impl/adder.hxx>
 
-#include <cmath>
-#include <iostream>
-#include <queue>
-#include <tuple>
+#include <algorithm>
+#include <cassert>
+#include <mutex>
 
 using namespace std;
 using namespace cingulata;
@@ -47,81 +46,172 @@ CiBitVector RippleCarryAdder::oper(const CiBitVector &lhs,
   return res;
 }
 
-namespace {
-void pre_computation(std::vector<CiBitVector> &P, std::vector<CiBitVector> &G,
-                     const CiBitVector &lhs, const CiBitVector &rhs) {
-  const int size = lhs.size();
-  for (int i = 0; i < size; ++i) {
-    P[i][i] = lhs[i] ^ rhs[i];
+pair<unsigned, unsigned> RippleCarryAdder::cost(const unsigned size) const {
+  return {size - 1, size - 1};
+}
+
+CiBitVector PrefixAdder::oper(const CiBitVector &lhs, const CiBitVector &rhs,
+                              const CiBit &carry_in) const {
+  const unsigned size = lhs.size();
+  const unsigned n = size - 1;
+
+  /**
+   * Group generate and propagate signals of positions [lo[i], i], the group
+   * propagate signal is not needed once the group reaches position 0
+   */
+  CiBitVector p = lhs ^ rhs;
+  CiBitVector g(n), gp(n);
+  vector<unsigned> lo(n);
+  for (unsigned i = 0; i < n; ++i) {
+    if (i == 0)
+      g[i] = ((lhs[i] ^ carry_in) & (rhs[i] ^ carry_in)) ^ carry_in;
+    else
+      g[i] = lhs[i] & rhs[i];
+    gp[i] = p[i];
+    lo[i] = i;
   }
-  /* G[size-1][size-1] will be unused */
-  for (int i = 0; i < size - 1; ++i) {
-    G[i][i] = lhs[i] & rhs[i];
+
+  for (const auto &ij : network(n)) {
+    const unsigned i = ij.first;
+    const unsigned j = ij.second;
+    assert(lo[i] == j + 1);
+    g[i] ^= gp[i] & g[j];
+    lo[i] = lo[j];
+    if (lo[i] > 0)
+      gp[i] &= gp[j];
   }
+
+  CiBitVector res(size);
+  res[0] = p[0] ^ carry_in;
+  for (unsigned i = 1; i < size; ++i)
+    res[i] = p[i] ^ g[i - 1];
+  return res;
 }
 
-void evaluate_G(std::vector<CiBitVector> &P, std::vector<CiBitVector> &G,
-                int row_index, int col_index, int step) {
-  int k = col_index + (int)pow(2, step - 1);
-  G[row_index][col_index] =
-      G[row_index][k] ^ (P[row_index][k] & G[k - 1][col_index]);
+pair<unsigned, unsigned> PrefixAdder::cost(const unsigned size) const {
+  const unsigned n = size - 1;
+
+  /* multiplicative depths of group signals */
+  vector<unsigned> dg(n, 1), dp(n, 0), lo(n);
+  for (unsigned i = 0; i < n; ++i)
+    lo[i] = i;
+
+  unsigned and_cnt = n;
+  for (const auto &ij : network(n)) {
+    const unsigned i = ij.first;
+    const unsigned j = ij.second;
+    dg[i] = max(dg[i], max(dp[i], dg[j]) + 1);
+    and_cnt++;
+    lo[i] = lo[j];
+    if (lo[i] > 0) {
+      dp[i] = max(dp[i], dp[j]) + 1;
+      and_cnt++;
+    }
+  }
+
+  const unsigned depth = n > 0 ? *max_element(dg.begin(), dg.end()) : 0;
+  return {and_cnt, depth};
 }
 
-void evaluate_P(std::vector<CiBitVector> &P, std::vector<CiBitVector> &G,
-                int row_index, int col_index, int step) {
-  int k = col_index + (int)pow(2, step - 1);
-  P[row_index][col_index] = P[row_index][k] & P[k - 1][col_index];
+vector<pair<unsigned, unsigned>>
+SklanskyAdder::network(const unsigned n) const {
+  vector<pair<unsigned, unsigned>> net;
+  for (unsigned d = 1; d < n; d *= 2) {
+    for (unsigned i = 0; i < n; ++i) {
+      /* groups are aligned blocks of d positions */
+      if (i & d)
+        net.emplace_back(i, (i & ~(2 * d - 1)) + d - 1);
+    }
+  }
+  return net;
 }
 
-CiBitVector post_computation(std::vector<CiBitVector> &P,
-                             std::vector<CiBitVector> &G, int size) {
-  CiBitVector res(size);
-  res[0] = P[0][0];
-  for (int i = 1; i < size; ++i)
-    res[i] = P[i][i] ^ G[i - 1][0];
-  return res;
+vector<pair<unsigned, unsigned>>
+KoggeStoneAdder::network(const unsigned n) const {
+  vector<pair<unsigned, unsigned>> net;
+  for (unsigned d = 1; d < n; d *= 2) {
+    /* top-down, lower positions are used before being updated */
+    for (unsigned i = n - 1; i >= d; --i)
+      net.emplace_back(i, i - d);
+  }
+  return net;
 }
-} // namespace
 
-CiBitVector SklanskyAdder::oper(const CiBitVector &lhs, const CiBitVector &rhs,
-                                const CiBit &carry_in) const {
-  CiBitVector res;
+vector<pair<unsigned, unsigned>>
+BrentKungAdder::network(const unsigned n) const {
+  vector<pair<unsigned, unsigned>> net;
+  unsigned d = 1;
+  for (; d < n; d *= 2) {
+    for (unsigned i = 2 * d - 1; i < n; i += 2 * d)
+      net.emplace_back(i, i - d);
+  }
+  for (d /= 4; d > 0; d /= 2) {
+    for (unsigned i = 3 * d - 1; i < n; i += 2 * d)
+      net.emplace_back(i, i - d);
+  }
+  return net;
+}
 
-  int size = lhs.size();
-  std::vector<CiBitVector> P(size, CiBitVector(size));
-  std::vector<CiBitVector> G(size, CiBitVector(size));
-  int num_steps = 0;
-  if (size > 1)
-    num_steps = (int)floor(log2((double)size - 1)) + 1;
-
-  /* compute initial G and P*/
-  pre_computation(P, G, lhs, rhs);
-
-  /* do for each level */
-  for (int step = 1; step <= num_steps; ++step) {
-    int row = 0;
-    int col = 0;
-    /* shift row */
-    row += (int)pow(2, step - 1);
-    /*   do while the size of enter is not reach*/
-    while (row < size - 1) {
-      /* define column value */
-      col = (int)floor(row / pow(2, step)) * (int)pow(2, step);
-      for (int i = 0; i < (int)pow(2, step - 1); ++i) {
-        evaluate_G(P, G, row, col, step);
-        if (col != 0)
-          evaluate_P(P, G, row, col, step);
-        /* increment row value */
-        row += 1;
-        /* case size is not multiple of 2 */
-        if (row == size - 1)
-          break;
-      }
-      row += (int)pow(2, step - 1);
+vector<pair<unsigned, unsigned>>
+HanCarlsonAdder::network(const unsigned n) const {
+  vector<pair<unsigned, unsigned>> net;
+  for (unsigned i = 1; i < n; i += 2)
+    net.emplace_back(i, i - 1);
+  for (unsigned d = 2; d < n; d *= 2) {
+    for (unsigned i = (n - 1) | 1; i > d; i -= 2) {
+      if (i < n)
+        net.emplace_back(i, i - d);
     }
   }
-  /* compute results*/
-  res = post_computation(P, G, size);
+  for (unsigned i = 2; i < n; i += 2)
+    net.emplace_back(i, i - 1);
+  return net;
+}
 
-  return res;
+CostModelAdder::CostModelAdder(const CostModelAdder &other)
+    : and_cost(other.and_cost), depth_cost(other.depth_cost) {
+  lock_guard<mutex> lock(other.selected_mtx);
+  selected = other.selected;
+}
+
+const AdderOper &CostModelAdder::select(const unsigned size) const {
+  const PrefixAdder *prefix_adders[] = {&sklansky, &brent_kung, &han_carlson,
+                                        &kogge_stone};
+  auto adder = [&](const int idx) -> const AdderOper & {
+    if (idx < 0)
+      return ripple_carry;
+    return *prefix_adders[idx];
+  };
+
+  {
+    lock_guard<mutex> lock(selected_mtx);
+    auto it = selected.find(size);
+    if (it != selected.end())
+      return adder(it->second);
+  }
+
+  auto cost = [&](const pair<unsigned, unsigned> &cnt) {
+    return (unsigned long)and_cost * cnt.first +
+           (unsigned long)depth_cost * cnt.second;
+  };
+
+  /* index of selected prefix adder, or -1 for ripple-carry adder */
+  int best = -1;
+  unsigned long best_cost = cost(ripple_carry.cost(size));
+  for (int i = 0; i < 4; ++i) {
+    const unsigned long c = cost(prefix_adders[i]->cost(size));
+    if (c < best_cost) {
+      best = i;
+      best_cost = c;
+    }
+  }
+
+  lock_guard<mutex> lock(selected_mtx);
+  selected.emplace(size, best);
+  return adder(best);
+}
+
+CiBitVector CostModelAdder::oper(const CiBitVector &lhs, const CiBitVector &rhs,
+                                 const CiBit &carry_in) const {
+  return select(lhs.size())(lhs, rhs, carry_in);
 }
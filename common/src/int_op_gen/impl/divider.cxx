@@ -0,0 +1,98 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <int_op_gen/impl/divider.hxx>
+
+using namespace std;
+using namespace cingulata;
+using namespace cingulata::int_ops;
+
+namespace {
+/* selects @c b if @c cond is set, @c a otherwise */
+CiBitVector select(const CiBit& cond, const CiBitVector& a, const CiBitVector& b) {
+  CiBitVector res(a);
+  for (unsigned i = 0; i < res.size(); ++i)
+    res[i] = op_mux(cond, a[i], b[i]);
+  return res;
+}
+} // namespace
+
+pair<CiBitVector, CiBitVector> DividerSize::oper(const CiBitVector& lhs,
+                                                 const CiBitVector& rhs) const {
+  const unsigned n = lhs.size();
+
+  /* high[w] is set when divisor has a set bit at position w or above */
+  vector<CiBit> high(n + 1, CiBit::zero);
+  for (unsigned w = n; w-- > 1;)
+    high[w] = high[w + 1] | rhs[w];
+
+  CiBitVector quo(n, CiBit::zero);
+  CiBitVector rem;
+  for (unsigned i = n; i-- > 0;) {
+    /* shift in next dividend bit, partial remainder has w bits */
+    rem.append(CiBit::zero).shr(1, lhs[i]);
+    const unsigned w = n - i;
+
+    CiBitVector a = rem;
+    CiBitVector b = rhs.slice(0, w);
+    a.append(CiBit::zero);
+    b.append(CiBit::zero);
+    const CiBitVector diff = sub(a, b);
+
+    /* rem >= rhs when there is no borrow and no divisor bit above w */
+    quo[i] = op_nor(diff[w], high[w]);
+    rem = select(quo[i], rem, diff.slice(0, w));
+  }
+
+  return {quo, rem};
+}
+
+pair<CiBitVector, CiBitVector> DividerDepth::oper(const CiBitVector& lhs,
+                                                  const CiBitVector& rhs) const {
+  const unsigned n = lhs.size();
+
+  /* high[w] is set when divisor has a set bit at position w or above,
+   * computed with a parallel prefix OR */
+  vector<CiBit> high(n + 1, CiBit::zero);
+  for (unsigned w = 1; w < n; ++w)
+    high[w] = rhs[w];
+  for (unsigned dist = 1; dist < n; dist *= 2) {
+    vector<CiBit> prev = high;
+    for (unsigned w = 1; w + dist < n; ++w)
+      high[w] = prev[w] | prev[w + dist];
+  }
+
+  CiBitVector quo(n, CiBit::zero);
+  CiBitVector rem;
+  for (unsigned i = n; i-- > 0;) {
+    /* shift in next dividend bit, partial remainder has w bits */
+    rem.append(CiBit::zero).shr(1, lhs[i]);
+    const unsigned w = n - i;
+
+    const CiBitVector b = rhs.slice(0, w);
+    const CiBitVector diff = sub(rem, b);
+
+    /* rem >= rhs when rem is not lower and no divisor bit is above w */
+    quo[i] = op_nor(lower(rem, b), high[w]);
+    rem = select(quo[i], rem, diff);
+  }
+
+  return {quo, rem};
+}
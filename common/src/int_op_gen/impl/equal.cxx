@@ -27,8 +27,11 @@ CiBit EqualDepth::oper(const CiBitVector& lhs, const CiBitVector& rhs) const {
   const int size = lhs.size();
 
   CiBitVector tmp(size, 0);
-  for (int i = 0; i < size; ++i)
+  for (int i = 0; i < size; ++i) {
     tmp[i] = lhs[i] == rhs[i];
+    if (tmp[i].is_plain() and tmp[i].get_val() == 0)
+      return CiBit::zero;
+  }
 
   /* log depth tree */
   return tmp.multvect();
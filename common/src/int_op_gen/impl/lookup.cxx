@@ -0,0 +1,90 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <int_op_gen/impl/lookup.hxx>
+
+using namespace std;
+using namespace cingulata;
+using namespace cingulata::int_ops;
+
+namespace {
+/**
+ * Product of bits @c c[i] for @c i in set @c s, which is a subset of
+ * [lo,hi). Sets are split in low and high halves of the range, as in
+ * #Decoder, so that sub-products are shared.
+ */
+CiBit monomial(const CiBitVector &c, vector<CiBit> &monos,
+               vector<bool> &done, const unsigned s, const unsigned lo,
+               const unsigned hi) {
+  if (s == 0)
+    return CiBit::one;
+  if (hi - lo == 1)
+    return c[lo];
+  if (done[s])
+    return monos[s];
+
+  const unsigned mid = lo + ((hi - lo) >> 1);
+  const unsigned s_lo = s & ((1U << mid) - 1);
+  const unsigned s_hi = s ^ s_lo;
+
+  if (s_hi == 0)
+    monos[s] = monomial(c, monos, done, s_lo, lo, mid);
+  else if (s_lo == 0)
+    monos[s] = monomial(c, monos, done, s_hi, mid, hi);
+  else
+    monos[s] = op_and(monomial(c, monos, done, s_lo, lo, mid),
+                      monomial(c, monos, done, s_hi, mid, hi));
+  done[s] = true;
+  return monos[s];
+}
+
+bool is_zero(const CiBitVector &v) {
+  for (unsigned i = 0; i < v.size(); ++i)
+    if (not v[i].is_plain() or v[i].get_val())
+      return false;
+  return true;
+}
+} // namespace
+
+CiBitVector LookupAnf::oper(const CiBitVector &cond,
+                            const vector<CiBitVector> &inps) const {
+  const unsigned m = cond.size();
+  const unsigned n = inps[0].size();
+
+  /* binary Moebius transform */
+  vector<CiBitVector> coefs = inps;
+  for (unsigned i = 0; i < m; ++i)
+    for (unsigned s = 0; s < coefs.size(); ++s)
+      if ((s >> i) & 1)
+        coefs[s] ^= coefs[s ^ (1U << i)];
+
+  vector<CiBit> monos(coefs.size());
+  vector<bool> done(coefs.size(), false);
+
+  CiBitVector res(n, 0);
+  for (unsigned s = 0; s < coefs.size(); ++s) {
+    if (is_zero(coefs[s]))
+      continue;
+    const CiBit mono = monomial(cond, monos, done, s, 0, m);
+    res ^= coefs[s] & CiBitVector(n, mono);
+  }
+
+  return res;
+}
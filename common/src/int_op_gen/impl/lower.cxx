@@ -20,22 +20,44 @@
 
 #include <int_op_gen/impl/lower.hxx>
 
+using namespace std;
 using namespace cingulata;
 using namespace cingulata::int_ops;
 
-CiBit LowerCompDepth::oper(const CiBitVector& lhs, const CiBitVector& rhs) const {
-  const int len = lhs.size();
-  if (len == 1) return CiBit(lhs[0]).op_andny(rhs[0]);
+namespace {
+/**
+ * Lower and equal bits of slices [begin, end) of @c lhs and @c rhs. The
+ * equal bit is computed only if @c with_equal is set, it is zero otherwise.
+ */
+pair<CiBit, CiBit> lower_equal(const CiBitVector& lhs, const CiBitVector& rhs,
+                               const int begin, const int end,
+                               const bool with_equal) {
+  if (end - begin == 1) {
+    return {op_andny(lhs[begin], rhs[begin]),
+            with_equal ? op_xnor(lhs[begin], rhs[begin]) : CiBit::zero};
+  }
 
-  const int len2 = len>>1;
-  CiBitVector lhs_l = lhs.slice(0,len2);
-  CiBitVector lhs_h = lhs.slice(len2);
-  CiBitVector rhs_l = rhs.slice(0,len2);
-  CiBitVector rhs_h = rhs.slice(len2);
+  const int mid = begin + ((end - begin) >> 1);
+  const pair<CiBit, CiBit> low = lower_equal(lhs, rhs, begin, mid, with_equal);
+
+  /* single high bit: result is rhs bit when high bits differ */
+  if (end - mid == 1) {
+    const CiBit diff = lhs[mid] ^ rhs[mid];
+    return {low.first ^ (diff & (low.first ^ rhs[mid])),
+            with_equal ? op_not(diff) & low.second : CiBit::zero};
+  }
 
-  return oper(lhs_h, rhs_h) ^ (equal(lhs_h, rhs_h) & oper(lhs_l, rhs_l));
+  const pair<CiBit, CiBit> high = lower_equal(lhs, rhs, mid, end, true);
+
+  /* lower and equal high parts are exclusive, XOR is an OR here */
+  return {high.first ^ (high.second & low.first),
+          with_equal ? high.second & low.second : CiBit::zero};
 }
+} // namespace
 
+CiBit LowerCompDepth::oper(const CiBitVector& lhs, const CiBitVector& rhs) const {
+  return lower_equal(lhs, rhs, 0, lhs.size(), false).first;
+}
 
 CiBit LowerCompSize::oper(const CiBitVector& lhs, const CiBitVector& rhs) const {
   const int size = lhs.size();
@@ -21,6 +21,8 @@
 #include <int_op_gen/impl/adder.hxx>
 #include <int_op_gen/impl/multiplier.hxx>
 
+#include <algorithm>
+#include <deque>
 #include <queue>
 #include <tuple>
 
@@ -28,49 +30,241 @@ using namespace std;
 using namespace cingulata;
 using namespace cingulata::int_ops;
 
+namespace {
+
+/**
+ * Reduce rows of same size to 2 with carry-save adders, shallowest rows
+ * first, and add the remaining rows with @c adder
+ */
+CiBitVector wallace_tree(const vector<CiBitVector> &rows,
+                         const function<BinaryOper::signature> &adder) {
+  if (rows.size() == 1)
+    return rows[0];
+
+  using T = tuple<int, CiBitVector>;
+  priority_queue<T, vector<T>, function<bool(const T &, const T &)>>
+  elems_sorted_by_depth(
+      [](const T &a, const T &b) -> bool { return get<0>(a) > get<0>(b); });
+
+  for (const CiBitVector &row : rows)
+    elems_sorted_by_depth.push(forward_as_tuple(1, row));
+
+  while (elems_sorted_by_depth.size() > 2) {
+    int da, db, dc;
+    CiBitVector a, b, c;
+
+    tie(da, a) = elems_sorted_by_depth.top();
+    elems_sorted_by_depth.pop();
+    tie(db, b) = elems_sorted_by_depth.top();
+    elems_sorted_by_depth.pop();
+    tie(dc, c) = elems_sorted_by_depth.top();
+    elems_sorted_by_depth.pop();
+
+    CiBitVector tmp1 = a ^ b ^ c;
+    a >>= 1;
+    b >>= 1;
+    c >>= 1;
+    CiBitVector tmp2 = ((a ^ c) & (b ^ c)) ^ c;
+
+    elems_sorted_by_depth.push(forward_as_tuple(dc, tmp1));
+    elems_sorted_by_depth.push(forward_as_tuple(dc + 1, tmp2));
+  }
+
+  int da, db;
+  CiBitVector a, b;
+
+  tie(da, a) = elems_sorted_by_depth.top();
+  elems_sorted_by_depth.pop();
+  tie(db, b) = elems_sorted_by_depth.top();
+  elems_sorted_by_depth.pop();
+
+  return adder(a, b);
+}
+
+bool is_zero(const CiBit &bit) { return bit.is_plain() and bit.get_val() == 0; }
+
+} // namespace
+
 CiBitVector WallaceMultiplier::oper(const CiBitVector &lhs,
                                     const CiBitVector &rhs) const {
   if (lhs.size() == 1) {
     CiBitVector res = lhs & rhs;
     return res;
   } else {
-    using T = tuple<int, CiBitVector>;
-    priority_queue<T, vector<T>, function<bool(const T &, const T &)>>
-    elems_sorted_by_depth(
-        [](const T &a, const T &b) -> bool { return get<0>(a) > get<0>(b); });
-
+    vector<CiBitVector> rows;
     for (unsigned int i = 0; i < lhs.size(); ++i)
-      elems_sorted_by_depth.push(forward_as_tuple(1, (rhs >> i) & CiBitVector(rhs.size(), lhs[i])));
-
-    while (elems_sorted_by_depth.size() > 2) {
-      int da, db, dc;
-      CiBitVector a, b, c;
-
-      tie(da, a) = elems_sorted_by_depth.top();
-      elems_sorted_by_depth.pop();
-      tie(db, b) = elems_sorted_by_depth.top();
-      elems_sorted_by_depth.pop();
-      tie(dc, c) = elems_sorted_by_depth.top();
-      elems_sorted_by_depth.pop();
-
-      CiBitVector tmp1 = a ^ b ^ c;
-      a >>= 1;
-      b >>= 1;
-      c >>= 1;
-      CiBitVector tmp2 = ((a ^ c) & (b ^ c)) ^ c;
-
-      elems_sorted_by_depth.push(forward_as_tuple(dc, tmp1));
-      elems_sorted_by_depth.push(forward_as_tuple(dc + 1, tmp2));
+      if (not is_zero(lhs[i]))
+        rows.push_back((rhs >> i) & CiBitVector(rhs.size(), lhs[i]));
+    if (rows.empty())
+      return CiBitVector(lhs.size(), CiBit::zero);
+    return wallace_tree(rows, adder);
+  }
+}
+
+CiBitVector DaddaMultiplier::oper(const CiBitVector &lhs,
+                                  const CiBitVector &rhs) const {
+  const unsigned n = lhs.size();
+  if (n == 1) {
+    CiBitVector res = lhs & rhs;
+    return res;
+  }
+
+  /* partial product bits by weight, products truncated to n bits */
+  vector<deque<CiBit>> cols(n);
+  for (unsigned i = 0; i < n; ++i) {
+    for (unsigned j = 0; i + j < n; ++j) {
+      CiBit pp = lhs[i] & rhs[j];
+      if (not is_zero(pp))
+        cols[i + j].push_back(pp);
     }
+  }
 
-    int da, db;
-    CiBitVector a, b;
+  /* Dadda heights below the tallest column, top column excepted */
+  size_t max_height = 0;
+  for (unsigned c = 0; c + 1 < n; ++c)
+    max_height = max(max_height, cols[c].size());
 
-    tie(da, a) = elems_sorted_by_depth.top();
-    elems_sorted_by_depth.pop();
-    tie(db, b) = elems_sorted_by_depth.top();
-    elems_sorted_by_depth.pop();
+  vector<size_t> heights = {2};
+  while (heights.back() * 3 / 2 < max_height)
+    heights.push_back(heights.back() * 3 / 2);
+
+  auto pop = [](deque<CiBit> &col) {
+    CiBit bit = col.front();
+    col.pop_front();
+    return bit;
+  };
+
+  for (auto d = heights.rbegin(); d != heights.rend(); ++d) {
+    for (unsigned c = 0; c + 1 < n; ++c) {
+      while (cols[c].size() > *d) {
+        CiBit a = pop(cols[c]);
+        CiBit b = pop(cols[c]);
+        if (cols[c].size() + 1 == *d) {
+          /* half adder */
+          cols[c].push_back(a ^ b);
+          cols[c + 1].push_back(a & b);
+        } else {
+          /* full adder */
+          CiBit x = pop(cols[c]);
+          cols[c].push_back(a ^ b ^ x);
+          cols[c + 1].push_back(((a ^ x) & (b ^ x)) ^ x);
+        }
+      }
+    }
+  }
+
+  /* carries of most significant column are dropped */
+  CiBit top = CiBit::zero;
+  for (const CiBit &bit : cols[n - 1])
+    top ^= bit;
+
+  CiBitVector a(n), b(n);
+  for (unsigned c = 0; c + 1 < n; ++c) {
+    if (cols[c].size() > 0)
+      a[c] = cols[c][0];
+    if (cols[c].size() > 1)
+      b[c] = cols[c][1];
+  }
+  a[n - 1] = top;
+
+  return adder(a, b);
+}
+
+CiBitVector KaratsubaMultiplier::oper(const CiBitVector &lhs,
+                                      const CiBitVector &rhs) const {
+  const unsigned n = lhs.size();
+  if (n < min_size or n < 2)
+    return mul(lhs, rhs);
+
+  const unsigned h = (n + 1) / 2;
+  const CiBitVector a0 = lhs.slice(0, h);
+  const CiBitVector a1 = lhs.slice(h, n);
+  const CiBitVector b0 = rhs.slice(0, h);
+  const CiBitVector b1 = rhs.slice(h, n);
+
+  /* a1*b1 is shifted by 2*h>=n, thus it does not contribute */
+  CiBitVector res = full(a0, b0).resize(n);
+
+  const CiBitVector cross =
+      adder((*this)(a1, b0.slice(0, n - h)), (*this)(a0.slice(0, n - h), b1));
+  const CiBitVector high = adder(res.slice(h, n), cross);
+  for (unsigned i = h; i < n; ++i)
+    res[i] = high[i - h];
 
-    return adder(a, b);
+  return res;
+}
+
+CiBitVector KaratsubaMultiplier::full(const CiBitVector &lhs,
+                                      const CiBitVector &rhs) const {
+  const unsigned m = lhs.size();
+  if (m < min_size or m < 2) {
+    CiBitVector a = lhs, b = rhs;
+    return mul(a.resize(2 * m), b.resize(2 * m));
   }
+
+  /* halves of equal size h, higher ones padded with zeros */
+  const unsigned h = (m + 1) / 2;
+  CiBitVector a0 = lhs.slice(0, h);
+  CiBitVector a1 = CiBitVector(lhs.slice(h, m)).resize(h);
+  CiBitVector b0 = rhs.slice(0, h);
+  CiBitVector b1 = CiBitVector(rhs.slice(h, m)).resize(h);
+
+  CiBitVector z0 = full(a0, b0);
+  CiBitVector z2 = full(a1, b1);
+
+  /* z1 = (a0+a1)*(b0+b1)-z0-z2 = a0*b1+a1*b0 */
+  const CiBitVector sa = adder(a0.resize(h + 1), a1.resize(h + 1));
+  const CiBitVector sb = adder(b0.resize(h + 1), b1.resize(h + 1));
+  const CiBitVector z02 =
+      adder(CiBitVector(z0).resize(2 * h + 2), CiBitVector(z2).resize(2 * h + 2));
+  CiBitVector z1 = sub(full(sa, sb), z02);
+
+  /* z0 and z2*2^(2h) do not overlap */
+  CiBitVector res = z0;
+  for (unsigned i = 0; i < z2.size(); ++i)
+    res.append(z2[i]);
+  res.resize(2 * m);
+
+  const CiBitVector high = adder(res.slice(h, 2 * m), z1.resize(2 * m - h));
+  for (unsigned i = h; i < 2 * m; ++i)
+    res[i] = high[i - h];
+
+  return res;
+}
+
+CiBitVector ConstMultiplier::oper(const CiBitVector &lhs,
+                                  const CiBitVector &rhs) const {
+  const unsigned n = lhs.size();
+
+  /**
+   * Canonical signed digits of rhs: an odd remaining value @c k gets digit
+   * @c 2-(k%4), thus next digit is zero. Negative digits rows use
+   * -(lhs<<i) = (~lhs<<i) + 2^i, the constant terms are summed in @c corr.
+   */
+  vector<CiBitVector> rows;
+  vector<bit_plain_t> corr(n, 0);
+  unsigned carry = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    assert(rhs[i].is_plain());
+    const unsigned s = rhs[i].get_val() + carry;
+    const bool next = i + 1 < n and rhs[i + 1].get_val();
+    if (s == 1 and not next) {
+      rows.push_back(lhs >> i);
+      carry = 0;
+    } else if (s == 1) {
+      rows.push_back(~lhs >> i);
+      for (unsigned j = i; j < n and (corr[j] ^= 1) == 0; ++j)
+        ;
+      carry = 1;
+    } else {
+      carry = s / 2;
+    }
+  }
+
+  if (find(corr.begin(), corr.end(), 1) != corr.end())
+    rows.push_back(CiBitVector(corr));
+
+  if (rows.empty())
+    return CiBitVector(n, CiBit::zero);
+  return wallace_tree(rows, adder);
 }
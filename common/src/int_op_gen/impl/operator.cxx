@@ -18,6 +18,7 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include <algorithm>
 #include <cassert>
 
 #include <int_op_gen/impl/operator.hxx>
@@ -46,7 +47,47 @@ CiBitVector AdderOper::operator()(const CiBitVector &lhs,
   assert(lhs.size() == rhs.size());
   assert(lhs.size() > 0);
 
-  return oper(lhs, rhs, carry_in);
+  const unsigned size = lhs.size();
+  CiBitVector res(size);
+
+  /* low bits with a plain-text carry */
+  CiBit carry = carry_in;
+  unsigned lo = 0;
+  for (; lo < size and carry.is_plain(); ++lo) {
+    const CiBit &a = lhs[lo];
+    const CiBit &b = rhs[lo];
+    if (a.is_plain() and b.is_plain()) {
+      res[lo] = a ^ b ^ carry;
+      carry = (a & b) ^ (carry & (a ^ b));
+    } else if (b.is_plain() and b.get_val() == carry.get_val()) {
+      res[lo] = a;
+    } else if (a.is_plain() and a.get_val() == carry.get_val()) {
+      res[lo] = b;
+    } else {
+      break;
+    }
+  }
+
+  if (lo == size)
+    return res;
+
+  /* high bits equal to plain-text zero, first one gets the carry out */
+  auto is_zero = [&](const unsigned i) {
+    return lhs[i].is_plain() and lhs[i].get_val() == 0 and
+           rhs[i].is_plain() and rhs[i].get_val() == 0;
+  };
+  unsigned hi = size;
+  while (hi > lo + 1 and is_zero(hi - 1) and is_zero(hi - 2))
+    hi--;
+
+  if (lo == 0 and hi == size)
+    return oper(lhs, rhs, carry);
+
+  const CiBitVector sum =
+      oper(lhs.slice(lo, hi), rhs.slice(lo, hi), carry);
+  for (unsigned i = lo; i < hi; ++i)
+    res[i] = sum[i - lo];
+  return res;
 }
 
 CiBitVector NaryOper::operator()(const vector<CiBitVector> &inps) const {
@@ -71,7 +112,31 @@ CiBit CompOper::operator()(const CiBitVector &lhs,
   assert(lhs.size() == rhs.size());
   assert(lhs.size() > 0);
 
-  return oper(lhs, rhs);
+  bool has_plain = false;
+  for (unsigned i = 0; i < lhs.size() and not has_plain; ++i)
+    has_plain = lhs[i].is_plain() and rhs[i].is_plain();
+  if (not has_plain)
+    return oper(lhs, rhs);
+
+  CiBitVector l, r;
+  for (unsigned i = 0; i < lhs.size(); ++i) {
+    if (lhs[i].is_plain() and rhs[i].is_plain()) {
+      if (lhs[i].get_val() == rhs[i].get_val())
+        continue;
+      l = CiBitVector();
+      r = CiBitVector();
+    }
+    l.append(lhs[i]);
+    r.append(rhs[i]);
+  }
+
+  /* equal inputs */
+  if (l.size() == 0) {
+    l.append(CiBit::zero);
+    r.append(CiBit::zero);
+  }
+
+  return oper(l, r);
 }
 
 CiBitVector MuxOper::operator()(const CiBitVector &cond,
@@ -92,6 +157,16 @@ CiBitVector MuxOper::operator()(const CiBitVector &cond,
 
   assert((1U << cond.size()) == inps.size());
 
+  bool plain_cond = true;
+  unsigned idx = 0;
+  for (unsigned i = 0; i < cond.size() and plain_cond; ++i) {
+    plain_cond = cond[i].is_plain();
+    if (plain_cond)
+      idx |= cond[i].get_val() << i;
+  }
+  if (plain_cond)
+    return inps[idx];
+
   if (cond.size() == 1) {
     const CiBit &c = cond[0];
     for (int i = 0; i < max_size; ++i)
@@ -123,7 +198,67 @@ vector<CiBitVector> SortOper::operator()(const vector<CiBitVector> &v_cbv,
   return oper(v_cbv, i_cbv, reverse);
 }
 
+vector<CiBitVector> TopKOper::operator()(const vector<CiBitVector> &v_cbv,
+                                         const vector<CiBitVector> &i_cbv,
+                                         const unsigned k,
+                                         const bool reverse) const {
+  assert(v_cbv.size() == i_cbv.size());
+
+  const unsigned n = min(k, (unsigned)v_cbv.size());
+  if (n == 0)
+    return vector<CiBitVector>();
+
+  return oper(v_cbv, i_cbv, n, reverse);
+}
+
 vector<CiBitVector> SortOper::operator()(const vector<CiBitVector> &v_cbv,
                                          const bool reverse) const {
   return (*this)(v_cbv, v_cbv, reverse);
 }
+
+CiBitVector ShiftOper::operator()(const CiBitVector &inp,
+                                  const CiBitVector &amount, const Mode mode,
+                                  const CiBit &fill) const {
+  if (inp.size() == 0 or amount.size() == 0)
+    return inp;
+
+  for (unsigned i = 0; i < amount.size(); ++i)
+    if (not amount[i].is_plain())
+      return oper(inp, amount, mode, fill);
+
+  /* plain-text amount, saturated for shifts and modulo size for rotations */
+  const unsigned n = inp.size();
+  unsigned sat = 0, rot = 0;
+  for (unsigned i = amount.size(); i-- > 0;) {
+    const unsigned bit = amount[i].get_val();
+    sat = min(2 * sat + bit, n);
+    rot = (2 * rot + bit) % n;
+  }
+
+  CiBitVector res(n);
+  for (unsigned i = 0; i < n; ++i) {
+    switch (mode) {
+    case Mode::SHL:
+      res[i] = i >= sat ? inp[i - sat] : fill;
+      break;
+    case Mode::SHR:
+      res[i] = i + sat < n ? inp[i + sat] : fill;
+      break;
+    case Mode::ROL:
+      res[i] = inp[(i + n - rot) % n];
+      break;
+    case Mode::ROR:
+      res[i] = inp[(i + rot) % n];
+      break;
+    }
+  }
+  return res;
+}
+
+pair<CiBitVector, CiBitVector> DivOper::operator()(const CiBitVector &lhs,
+                                                   const CiBitVector &rhs) const {
+  assert(lhs.size() == rhs.size());
+  assert(lhs.size() > 0);
+
+  return oper(lhs, rhs);
+}
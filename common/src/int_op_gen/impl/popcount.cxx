@@ -0,0 +1,101 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <int_op_gen/impl/popcount.hxx>
+
+#include <queue>
+
+using namespace std;
+using namespace cingulata;
+using namespace cingulata::int_ops;
+
+namespace {
+/* bit and its multiplicative depth relative to inputs */
+using DepthBit = pair<unsigned, CiBit>;
+
+struct Deeper {
+  bool operator()(const DepthBit &a, const DepthBit &b) const {
+    return a.first > b.first;
+  }
+};
+
+using Column = priority_queue<DepthBit, vector<DepthBit>, Deeper>;
+
+DepthBit pop(Column &col) {
+  DepthBit b = col.top();
+  col.pop();
+  return b;
+}
+} // namespace
+
+CiBitVector PopCount::oper(const CiBitVector &inp) const {
+  unsigned ct_cnt = 0;
+  unsigned pt_cnt = 0;
+  for (unsigned i = 0; i < inp.size(); ++i) {
+    if (not inp[i].is_plain())
+      ct_cnt++;
+    else if (inp[i].get_val())
+      pt_cnt++;
+  }
+
+  unsigned size = 1;
+  while ((ct_cnt + pt_cnt) >> size)
+    size++;
+
+  vector<Column> cols(size);
+  for (unsigned i = 0; i < inp.size(); ++i)
+    if (not inp[i].is_plain())
+      cols[0].emplace(0, inp[i]);
+  for (unsigned k = 0; k < size; ++k)
+    if ((pt_cnt >> k) & 1)
+      cols[k].emplace(0, CiBit::one);
+
+  CiBitVector res(size, 0);
+  for (unsigned k = 0; k < size; ++k) {
+    Column &col = cols[k];
+
+    /* carries out of the most significant column are zero */
+    if (k == size - 1) {
+      while (not col.empty())
+        res[k] ^= pop(col).second;
+      break;
+    }
+
+    while (col.size() >= 3) {
+      const DepthBit a = pop(col);
+      const DepthBit b = pop(col);
+      const DepthBit c = pop(col);
+      const unsigned d = max(max(a.first, b.first), c.first);
+      col.emplace(d, a.second ^ b.second ^ c.second);
+      cols[k + 1].emplace(d + 1, ((a.second ^ c.second) & (b.second ^ c.second)) ^ c.second);
+    }
+
+    if (col.size() == 2) {
+      const DepthBit a = pop(col);
+      const DepthBit b = pop(col);
+      res[k] = a.second ^ b.second;
+      cols[k + 1].emplace(max(a.first, b.first) + 1, a.second & b.second);
+    } else if (col.size() == 1) {
+      res[k] = pop(col).second;
+    }
+  }
+
+  return res;
+}
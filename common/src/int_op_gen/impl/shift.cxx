@@ -0,0 +1,139 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <int_op_gen/impl/dec.hxx>
+#include <int_op_gen/impl/shift.hxx>
+
+#include <vector>
+
+using namespace std;
+using namespace cingulata;
+using namespace cingulata::int_ops;
+
+namespace {
+bool is_rotate(const ShiftOper::Mode mode) {
+  return mode == ShiftOper::Mode::ROL or mode == ShiftOper::Mode::ROR;
+}
+
+/* shift or rotate by a plaintext number of positions */
+CiBitVector shift(const CiBitVector& inp, const unsigned pos,
+                  const ShiftOper::Mode mode, const CiBit& fill) {
+  const unsigned n = inp.size();
+  CiBitVector res(n, fill);
+  for (unsigned i = 0; i < n; ++i) {
+    switch (mode) {
+      case ShiftOper::Mode::SHL:
+        if (i >= pos) res[i] = inp[i - pos];
+        break;
+      case ShiftOper::Mode::SHR:
+        if (i + pos < n) res[i] = inp[i + pos];
+        break;
+      case ShiftOper::Mode::ROL:
+        res[i] = inp[(i + n - pos % n) % n];
+        break;
+      case ShiftOper::Mode::ROR:
+        res[i] = inp[(i + pos) % n];
+        break;
+    }
+  }
+  return res;
+}
+
+/* selects @c b if @c cond is set, @c a otherwise */
+CiBitVector select(const CiBit& cond, const CiBitVector& a, const CiBitVector& b) {
+  CiBitVector res(a);
+  for (unsigned i = 0; i < res.size(); ++i)
+    res[i] = op_mux(cond, a[i], b[i]);
+  return res;
+}
+
+/* logarithmic depth OR of bits @c bits[begin..end) */
+CiBit or_tree(const CiBitVector& bits, const unsigned begin, const unsigned end) {
+  if (begin >= end) return CiBit::zero;
+  if (begin + 1 == end) return bits[begin];
+  const unsigned mid = (begin + end) / 2;
+  return or_tree(bits, begin, mid) | or_tree(bits, mid, end);
+}
+
+/* rotation stages for amount bits @c amount[begin..] */
+CiBitVector rotate_stages(CiBitVector res, const CiBitVector& amount,
+                          const unsigned begin, const ShiftOper::Mode mode) {
+  const unsigned n = res.size();
+  unsigned step = 1 % n;
+  for (unsigned j = 0; j < begin; ++j)
+    step = 2 * step % n;
+
+  for (unsigned j = begin; j < amount.size(); ++j) {
+    if (step != 0)
+      res = select(amount[j], res, shift(res, step, mode, CiBit::zero));
+    step = 2 * step % n;
+  }
+  return res;
+}
+} // namespace
+
+CiBitVector ShiftSize::oper(const CiBitVector& inp, const CiBitVector& amount,
+                            const Mode mode, const CiBit& fill) const {
+  if (is_rotate(mode))
+    return rotate_stages(inp, amount, 0, mode);
+
+  const unsigned n = inp.size();
+  CiBitVector res = inp;
+  unsigned j = 0;
+  for (unsigned step = 1; j < amount.size() and step < n; ++j, step *= 2)
+    res = select(amount[j], res, shift(res, step, mode, fill));
+
+  /* remaining amount bits shift all input bits out */
+  if (j < amount.size()) {
+    CiBit ovf = amount[j];
+    for (++j; j < amount.size(); ++j)
+      ovf |= amount[j];
+    res = select(ovf, res, CiBitVector(n, fill));
+  }
+
+  return res;
+}
+
+CiBitVector ShiftDepth::oper(const CiBitVector& inp, const CiBitVector& amount,
+                             const Mode mode, const CiBit& fill) const {
+  const static Decoder decoder;
+  const unsigned n = inp.size();
+
+  /* number of decoded amount bits */
+  unsigned l = 0;
+  while ((1u << l) < n and l < amount.size())
+    l++;
+
+  CiBitVector res = inp;
+  if (l > 0) {
+    const CiBitVector dec = decoder(amount.slice(0, l));
+    res = CiBitVector(n, CiBit::zero);
+    for (unsigned k = 0; k < dec.size(); ++k)
+      res ^= shift(inp, k, mode, fill) & CiBitVector(n, dec[k]);
+  }
+
+  if (is_rotate(mode))
+    return rotate_stages(res, amount, l, mode);
+
+  if (l < amount.size())
+    res = select(or_tree(amount, l, amount.size()), res, CiBitVector(n, fill));
+
+  return res;
+}
@@ -27,28 +27,6 @@ using namespace std;
 using namespace cingulata;
 using namespace cingulata::int_ops;
 
-CiBitVector SortDepth::hammingWeight(const CiBitVector x, unsigned int l,
-                                     unsigned int size_ham) const {
-  unsigned int m = floor(l / 2);
-  unsigned int n = l - m;
-  if (l == 1) {
-    CiBitVector r(size_ham);
-    r[0] = x[0];
-    return r;
-  }
-  CiBitVector left(m);
-  CiBitVector right(n);
-  for (unsigned int i = 0; i < m; i++) {
-    left[i] = x[i];
-  }
-
-  for (unsigned int i = m; i < m + n; i++) {
-    right[i - m] = x[i];
-  }
-  return (adder(hammingWeight(left, m, size_ham),
-                hammingWeight(right, n, size_ham)));
-}
-
 vector<CiBitVector> SortDepth::oper(const vector<CiBitVector> &v_cbv,
                                     const vector<CiBitVector> &i_cbv,
                                     const bool reverse) const {
@@ -76,7 +54,7 @@ vector<CiBitVector> SortDepth::oper(const vector<CiBitVector> &v_cbv,
   unsigned int size_ham = ceil(log2(N)) + 1;
   vector<CiBitVector> hamming_weights(N, CiBitVector(size_ham));
   for (unsigned int i = 0; i < N; i++) {
-    hamming_weights[i] = SortDepth::hammingWeight(m[i], N, size_ham);
+    hamming_weights[i] = popcount(m[i]).resize(size_ham);
   }
 
   for (unsigned int i = 0; i < N; i++) {
@@ -90,3 +68,74 @@ vector<CiBitVector> SortDepth::oper(const vector<CiBitVector> &v_cbv,
 
   return res;
 }
+
+vector<pair<unsigned, unsigned>> SortSize::comparators(const unsigned n) const {
+  unsigned size = 1;
+  while (size < n)
+    size *= 2;
+
+  /* missing elements are extremal values at the end, they never move */
+  vector<pair<unsigned, unsigned>> res;
+  auto add = [&](const unsigned i, const unsigned j) {
+    if (j < n)
+      res.emplace_back(i, j);
+  };
+
+  if (network == Network::ODD_EVEN_MERGE) {
+    for (unsigned p = 1; p < size; p *= 2)
+      for (unsigned k = p; k >= 1; k /= 2)
+        for (unsigned j = k % p; j + k < size; j += 2 * k)
+          for (unsigned i = 0; i < k and i + j + k < size; ++i)
+            if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+              add(i + j, i + j + k);
+  } else {
+    /* first merge step of each stage compares mirrored elements, thus
+     * every unit puts the smallest element on the lowest index */
+    for (unsigned k = 2; k <= size; k *= 2)
+      for (unsigned j = k / 2; j > 0; j /= 2)
+        for (unsigned i = 0; i < size; ++i) {
+          const unsigned l = (j == k / 2) ? (i ^ (k - 1)) : (i ^ j);
+          if (l > i)
+            add(i, l);
+        }
+  }
+
+  return res;
+}
+
+vector<CiBitVector> SortSize::oper(const vector<CiBitVector> &v_cbv,
+                                   const vector<CiBitVector> &i_cbv,
+                                   const bool reverse) const {
+  /* sort values only when keys are also the sorted values */
+  const bool same = (&v_cbv == &i_cbv);
+
+  auto resized = [](vector<CiBitVector> vec) {
+    unsigned max_size = 0;
+    for (const CiBitVector &elem : vec)
+      max_size = max(max_size, (unsigned)elem.size());
+    for (CiBitVector &elem : vec)
+      elem.resize(max_size);
+    return vec;
+  };
+
+  vector<CiBitVector> keys = resized(v_cbv);
+  vector<CiBitVector> vals = same ? vector<CiBitVector>() : resized(i_cbv);
+
+  /* conditional swap, one AND gate per bit */
+  auto cond_swap = [](const CiBit &c, CiBitVector &a, CiBitVector &b) {
+    const CiBitVector d = (a ^ b) & CiBitVector(a.size(), c);
+    a ^= d;
+    b ^= d;
+  };
+
+  for (const auto &cmp_exch : comparators(keys.size())) {
+    CiBitVector &a = keys[cmp_exch.first];
+    CiBitVector &b = keys[cmp_exch.second];
+    const CiBit c = reverse ? cmp(a, b) : cmp(b, a);
+    cond_swap(c, a, b);
+    if (not same)
+      cond_swap(c, vals[cmp_exch.first], vals[cmp_exch.second]);
+  }
+
+  return same ? keys : vals;
+}
@@ -0,0 +1,120 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <int_op_gen/impl/top_k.hxx>
+
+#include <algorithm>
+
+using namespace std;
+using namespace cingulata;
+using namespace cingulata::int_ops;
+
+vector<CiBitVector> TopK::oper(const vector<CiBitVector> &v_cbv,
+                               const vector<CiBitVector> &i_cbv,
+                               const unsigned k, const bool reverse) const {
+  /* select values only when keys are also the selected values */
+  const bool same = (&v_cbv == &i_cbv);
+  const unsigned n = v_cbv.size();
+
+  unsigned key_size = 0;
+  for (const CiBitVector &elem : v_cbv)
+    key_size = max(key_size, (unsigned)elem.size());
+
+  unsigned val_size = 0;
+  for (const CiBitVector &elem : i_cbv)
+    val_size = max(val_size, (unsigned)elem.size());
+
+  unsigned blk = 1;
+  while (blk < k)
+    blk *= 2;
+
+  unsigned blk_cnt = 1;
+  while (blk_cnt * blk < n)
+    blk_cnt *= 2;
+
+  /* most significant key bit puts missing elements last */
+  vector<CiBitVector> keys(blk_cnt * blk,
+                           CiBitVector(key_size + 1, CiBit(not reverse)));
+  vector<CiBitVector> vals(same ? 0 : blk_cnt * blk, CiBitVector(val_size));
+  for (unsigned i = 0; i < n; ++i) {
+    keys[i] = v_cbv[i];
+    keys[i].resize(key_size).append(CiBit(reverse));
+    if (not same) {
+      vals[i] = i_cbv[i];
+      vals[i].resize(val_size);
+    }
+  }
+
+  /* elements are ordered if comparison result is zero */
+  auto order = [&](const unsigned i, const unsigned j) {
+    return reverse ? cmp(keys[i], keys[j]) : cmp(keys[j], keys[i]);
+  };
+
+  /* compare-exchange, one AND gate per bit */
+  auto cmp_exch = [&](const unsigned i, const unsigned j) {
+    const CiBit c = order(i, j);
+    CiBitVector d = (keys[i] ^ keys[j]) & CiBitVector(key_size + 1, c);
+    keys[i] ^= d;
+    keys[j] ^= d;
+    if (not same) {
+      d = (vals[i] ^ vals[j]) & CiBitVector(val_size, c);
+      vals[i] ^= d;
+      vals[j] ^= d;
+    }
+  };
+
+  /* keeps first of two elements in @c i */
+  auto keep_first = [&](const unsigned i, const unsigned j) {
+    const CiBit c = order(i, j);
+    keys[i] ^= (keys[i] ^ keys[j]) & CiBitVector(key_size + 1, c);
+    if (not same)
+      vals[i] ^= (vals[i] ^ vals[j]) & CiBitVector(val_size, c);
+  };
+
+  const auto blk_net = sorter.comparators(blk);
+  for (unsigned b = 0; b < blk_cnt; ++b)
+    for (const auto &p : blk_net)
+      cmp_exch(b * blk + p.first, b * blk + p.second);
+
+  for (unsigned step = 1; step < blk_cnt; step *= 2) {
+    for (unsigned b = 0; b < blk_cnt; b += 2 * step) {
+      const unsigned lo = b * blk;
+      const unsigned hi = (b + step) * blk;
+
+      for (unsigned i = 0; i < blk; ++i)
+        keep_first(lo + i, hi + blk - 1 - i);
+
+      /* bitonic merge */
+      for (unsigned j = blk / 2; j > 0; j /= 2)
+        for (unsigned i = 0; i < blk; ++i)
+          if ((i & j) == 0)
+            cmp_exch(lo + i, lo + i + j);
+    }
+  }
+
+  vector<CiBitVector> res;
+  for (unsigned i = 0; i < k; ++i) {
+    if (same)
+      res.push_back(keys[i].resize(key_size));
+    else
+      res.push_back(vals[i]);
+  }
+  return res;
+}
@@ -20,15 +20,30 @@
 
 #include <int_op_gen/interface.hxx>
 
+#include <algorithm>
+#include <cassert>
+
 using namespace std;
 using namespace cingulata;
 
 IIntOpGen::IIntOpGen()
-    : m_multi_input_adder(
+    : m_sort_depth_max_size(0),
+      m_multi_input_adder(
           bind(&IIntOpGen::add, this, placeholders::_1, placeholders::_2)),
       m_sort{bind(&IIntOpGen::lower, this, placeholders::_1, placeholders::_2),
              bind(&IIntOpGen::equal, this, placeholders::_1, placeholders::_2),
-             bind(&IIntOpGen::add, this, placeholders::_1, placeholders::_2)} {}
+             bind(&IIntOpGen::popcount, this, placeholders::_1)},
+      m_sort_size{
+          bind(&IIntOpGen::lower, this, placeholders::_1, placeholders::_2)},
+      m_top_k{
+          bind(&IIntOpGen::lower, this, placeholders::_1, placeholders::_2)} {}
+
+bool IIntOpGen::is_plain(const CiBitVector &inp) {
+  for (unsigned i = 0; i < inp.size(); ++i)
+    if (not inp[i].is_plain())
+      return false;
+  return true;
+}
 
 CiBitVector IIntOpGen::sub(const CiBitVector &lhs,
                            const CiBitVector &rhs) const {
@@ -39,6 +54,16 @@ CiBitVector IIntOpGen::square(const CiBitVector &rhs) const {
   return mul(rhs, rhs);
 }
 
+CiBitVector IIntOpGen::div(const CiBitVector &lhs,
+                           const CiBitVector &rhs) const {
+  return divmod(lhs, rhs).first;
+}
+
+CiBitVector IIntOpGen::mod(const CiBitVector &lhs,
+                           const CiBitVector &rhs) const {
+  return divmod(lhs, rhs).second;
+}
+
 CiBit IIntOpGen::not_equal(const CiBitVector &lhs,
                            const CiBitVector &rhs) const {
   return !equal(lhs, rhs);
@@ -68,12 +93,70 @@ CiBitVector IIntOpGen::mux(const CiBitVector &cond,
   return m_mux(cond, inps);
 }
 
+CiBitVector IIntOpGen::lookup(const CiBitVector &idx,
+                              const vector<CiBitVector> &table) const {
+  if (table.empty())
+    return CiBitVector();
+
+  unsigned size = 0;
+  for (const CiBitVector &elem : table)
+    size = max(size, elem.size());
+
+  /* only the low index bits needed to address the table are selectors */
+  unsigned sel_size = 0;
+  while (sel_size < idx.size() and (1UL << sel_size) < table.size())
+    sel_size++;
+
+  CiBitVector sel = idx;
+  sel.resize(sel_size);
+
+  vector<CiBitVector> inps = table;
+  inps.resize(1UL << sel_size, CiBitVector(size, CiBit::zero));
+  for (CiBitVector &inp : inps)
+    inp.resize(size);
+
+  bool plain_table = true;
+  for (const CiBitVector &inp : inps)
+    plain_table = plain_table and is_plain(inp);
+  CiBitVector res = plain_table ? m_lookup(sel, inps) : m_mux(sel, inps);
+
+  /* indices out of range, ie with a high bit set, select zero */
+  vector<CiBit> high;
+  for (unsigned i = sel_size; i < idx.size(); ++i)
+    high.push_back(idx[i]);
+  while (high.size() > 1) {
+    for (unsigned i = 0; i + 1 < high.size(); i += 2)
+      high[i / 2] = high[i] | high[i + 1];
+    if (high.size() % 2)
+      high[high.size() / 2] = high.back();
+    high.resize((high.size() + 1) / 2);
+  }
+  if (not high.empty())
+    res.op_andyn(high[0]);
+
+  return res;
+}
+
 vector<CiBitVector> IIntOpGen::sort(const vector<CiBitVector> &v_cbv,
                                     const vector<CiBitVector> &i_cbv,
                                     const bool reverse) const {
-  return m_sort(v_cbv, i_cbv, reverse);
+  if (v_cbv.size() <= m_sort_depth_max_size)
+    return m_sort(v_cbv, i_cbv, reverse);
+  else
+    return m_sort_size(v_cbv, i_cbv, reverse);
+}
+
+vector<CiBitVector> IIntOpGen::top_k(const vector<CiBitVector> &v_cbv,
+                                     const vector<CiBitVector> &i_cbv,
+                                     const unsigned k,
+                                     const bool reverse) const {
+  return m_top_k(v_cbv, i_cbv, k, reverse);
 }
 
 CiBitVector IIntOpGen::sum(const vector<CiBitVector> &inps) const {
   return m_multi_input_adder(inps);
 }
+
+CiBitVector IIntOpGen::popcount(const CiBitVector &inp) const {
+  return m_popcount(inp);
+}
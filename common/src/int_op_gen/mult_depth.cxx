@@ -23,19 +23,37 @@
 using namespace std;
 using namespace cingulata;
 
-IntOpGenDepth::IntOpGenDepth() : m_neg{m_add}, m_mul{m_add}, m_lower{m_equal} {}
+/* adders cost model: a multiplicative level costs as much as a thousand AND
+ * gates */
+IntOpGenDepth::IntOpGenDepth()
+    : m_add{1, 1000}, m_neg{m_add}, m_mul{m_add}, m_mul_const{m_add},
+      m_div{bind(&IntOpGenDepth::sub, this, placeholders::_1, placeholders::_2),
+            bind(&IntOpGenDepth::lower, this, placeholders::_1,
+                 placeholders::_2)} {
+  /* quadratic size of minimal depth sorter is prohibitive beyond */
+  m_sort_depth_max_size = 64;
+}
 
 CiBitVector IntOpGenDepth::add(const CiBitVector &lhs,
                                const CiBitVector &rhs) const {
   return m_add(lhs, rhs);
 }
 
+CiBitVector IntOpGenDepth::sub(const CiBitVector &lhs,
+                               const CiBitVector &rhs) const {
+  return m_add(lhs, ~rhs, CiBit::one);
+}
+
 CiBitVector IntOpGenDepth::neg(const CiBitVector &lhs) const {
   return m_neg(lhs);
 }
 
 CiBitVector IntOpGenDepth::mul(const CiBitVector &lhs,
                                const CiBitVector &rhs) const {
+  if (is_plain(rhs))
+    return m_mul_const(lhs, rhs);
+  if (is_plain(lhs))
+    return m_mul_const(rhs, lhs);
   return m_mul(lhs, rhs);
 }
 
@@ -48,3 +66,30 @@ CiBit IntOpGenDepth::lower(const CiBitVector &lhs,
                            const CiBitVector &rhs) const {
   return m_lower(lhs, rhs);
 }
+
+pair<CiBitVector, CiBitVector>
+IntOpGenDepth::divmod(const CiBitVector &lhs, const CiBitVector &rhs) const {
+  return m_div(lhs, rhs);
+}
+
+CiBitVector IntOpGenDepth::shl(const CiBitVector &lhs,
+                               const CiBitVector &amount,
+                               const CiBit &fill) const {
+  return m_shift(lhs, amount, int_ops::ShiftOper::Mode::SHL, fill);
+}
+
+CiBitVector IntOpGenDepth::shr(const CiBitVector &lhs,
+                               const CiBitVector &amount,
+                               const CiBit &fill) const {
+  return m_shift(lhs, amount, int_ops::ShiftOper::Mode::SHR, fill);
+}
+
+CiBitVector IntOpGenDepth::rol(const CiBitVector &lhs,
+                               const CiBitVector &amount) const {
+  return m_shift(lhs, amount, int_ops::ShiftOper::Mode::ROL);
+}
+
+CiBitVector IntOpGenDepth::ror(const CiBitVector &lhs,
+                               const CiBitVector &amount) const {
+  return m_shift(lhs, amount, int_ops::ShiftOper::Mode::ROR);
+}
@@ -22,7 +22,16 @@
 
 using namespace cingulata;
 
-IntOpGenSize::IntOpGenSize() : m_neg{m_add}, m_mul{m_add} {}
+/* adders cost model: number of AND gates */
+IntOpGenSize::IntOpGenSize()
+    : m_add{1, 0}, m_neg{m_add}, m_mul{m_add},
+      m_mul_karatsuba{m_add,
+                      std::bind(&IntOpGenSize::sub, this, std::placeholders::_1,
+                                std::placeholders::_2),
+                      m_mul, 16},
+      m_mul_const{m_add},
+      m_div{std::bind(&IntOpGenSize::sub, this, std::placeholders::_1,
+                      std::placeholders::_2)} {}
 
 CiBitVector IntOpGenSize::add(const CiBitVector &lhs,
                               const CiBitVector &rhs) const {
@@ -40,6 +49,14 @@ CiBitVector IntOpGenSize::neg(const CiBitVector &lhs) const {
 
 CiBitVector IntOpGenSize::mul(const CiBitVector &lhs,
                               const CiBitVector &rhs) const {
+  if (is_plain(rhs))
+    return m_mul_const(lhs, rhs);
+  if (is_plain(lhs))
+    return m_mul_const(rhs, lhs);
+
+  /* Karatsuba multiplier uses fewer AND gates from 40 bits on */
+  if (lhs.size() >= 40)
+    return m_mul_karatsuba(lhs, rhs);
   return m_mul(lhs, rhs);
 }
 
@@ -52,3 +69,28 @@ CiBit IntOpGenSize::lower(const CiBitVector &lhs,
                           const CiBitVector &rhs) const {
   return m_lower(lhs, rhs);
 }
+
+std::pair<CiBitVector, CiBitVector>
+IntOpGenSize::divmod(const CiBitVector &lhs, const CiBitVector &rhs) const {
+  return m_div(lhs, rhs);
+}
+
+CiBitVector IntOpGenSize::shl(const CiBitVector &lhs, const CiBitVector &amount,
+                              const CiBit &fill) const {
+  return m_shift(lhs, amount, int_ops::ShiftOper::Mode::SHL, fill);
+}
+
+CiBitVector IntOpGenSize::shr(const CiBitVector &lhs, const CiBitVector &amount,
+                              const CiBit &fill) const {
+  return m_shift(lhs, amount, int_ops::ShiftOper::Mode::SHR, fill);
+}
+
+CiBitVector IntOpGenSize::rol(const CiBitVector &lhs,
+                              const CiBitVector &amount) const {
+  return m_shift(lhs, amount, int_ops::ShiftOper::Mode::ROL);
+}
+
+CiBitVector IntOpGenSize::ror(const CiBitVector &lhs,
+                              const CiBitVector &amount) const {
+  return m_shift(lhs, amount, int_ops::ShiftOper::Mode::ROR);
+}
@@ -0,0 +1,302 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <bit_exec/clear.hxx>
+#include <bit_exec/trace.hxx>
+#include <bit_exec/tracker.hxx>
+#include <ci_context.hxx>
+#include <ci_fncs.hxx>
+#include <ci_int.hxx>
+#include <int_op_gen/cache.hxx>
+#include <int_op_gen/size.hxx>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <sstream>
+
+using namespace std;
+using namespace cingulata;
+
+namespace {
+/**
+ * @brief      Tracks the circuit of @c select(a<b,a-b,a|~b) for 8-bit unsigned
+ *             integers
+ */
+void track_circuit(const shared_ptr<BitTracker> &tracker) {
+  shared_ptr<IBitExec> bit_exec = CiContext::get_bit_exec();
+  shared_ptr<IIntOpGen> int_op_gen = CiContext::get_int_op_gen();
+  CiContext::set_config(tracker, make_shared<IntOpGenSize>());
+
+  CiInt a(0, 8, false);
+  CiInt b(0, 8, false);
+  a.encrypt();
+  b.encrypt();
+
+  CiInt c = select(a < b, a - b, a | ~b);
+  for (unsigned i = 0; i < c.size(); ++i)
+    c[i].decrypt();
+
+  CiContext::set_config(bit_exec, int_op_gen);
+}
+
+unsigned expected(const unsigned a, const unsigned b) {
+  return (a < b ? a - b : a | ~b) & 0xFF;
+}
+
+/**
+ * @brief      Replays @c trace on clear-text executor and compares with
+ *             expected results
+ */
+void check_trace(const Trace &trace) {
+  BitExecClear exec;
+
+  for (unsigned a = 0; a < 256; a += 11) {
+    for (unsigned b = 0; b < 256; b += 5) {
+      vector<ObjHandle> inps;
+      for (unsigned i = 0; i < 8; ++i)
+        inps.push_back(exec.encode((a >> i) & 1));
+      for (unsigned i = 0; i < 8; ++i)
+        inps.push_back(exec.encode((b >> i) & 1));
+
+      vector<ObjHandle> outs = trace.replay(exec, inps);
+      unsigned val = 0;
+      for (unsigned i = 0; i < outs.size(); ++i)
+        val |= (exec.decrypt(outs[i]) & 1) << i;
+
+      ASSERT_EQ(val, expected(a, b));
+    }
+  }
+}
+
+/**
+ * @brief      Evaluates a BLIF circuit given as text, nodes can be declared in
+ *             any order but must be defined before their use
+ */
+map<string, bool> eval_blif(const string &blif,
+                            const map<string, bool> &inps) {
+  map<string, bool> vals(inps);
+  istringstream stream(blif);
+  string line;
+  getline(stream, line);
+  while (not stream.eof()) {
+    if (line.rfind(".names", 0) != 0) {
+      getline(stream, line);
+      continue;
+    }
+
+    istringstream names(line.substr(6));
+    vector<string> nodes;
+    string node;
+    while (names >> node)
+      nodes.push_back(node);
+    const string out = nodes.back();
+    nodes.pop_back();
+
+    bool on_set = true, match = false;
+    while (getline(stream, line) and not line.empty() and line[0] != '.') {
+      istringstream cover(line);
+      string row, res = "1";
+      if (not nodes.empty())
+        cover >> row;
+      cover >> res;
+      on_set = (res == "1");
+
+      bool row_match = true;
+      for (unsigned i = 0; i < nodes.size(); ++i) {
+        if (row[i] != '-' and (row[i] == '1') != vals.at(nodes[i]))
+          row_match = false;
+      }
+      match = match or row_match;
+    }
+    vals[out] = (match == on_set);
+  }
+  return vals;
+}
+
+unsigned count(const Trace &trace, const Trace::Op op) {
+  unsigned cnt = 0;
+  for (const Trace::Node &node : trace.nodes())
+    cnt += (node.op == op);
+  return cnt;
+}
+
+/**
+ * @brief      Number of gates which need a bootstrapping in TFHE
+ */
+unsigned bootstrap_count(const Trace &trace) {
+  unsigned cnt = 0;
+  for (const Trace::Node &node : trace.nodes()) {
+    switch (node.op) {
+    case Trace::Op::INPUT:
+    case Trace::Op::ZERO:
+    case Trace::Op::ONE:
+    case Trace::Op::NOT:
+    case Trace::Op::BUF:
+      break;
+    case Trace::Op::MUX:
+      cnt += 2;
+      break;
+    default:
+      cnt += 1;
+    }
+  }
+  return cnt;
+}
+} // namespace
+
+TEST(BitTracker, native_gates) {
+  shared_ptr<BitTracker> tracker = make_shared<BitTrackerFHE>();
+  track_circuit(tracker);
+
+  Trace trace = tracker->export_trace();
+  ASSERT_GT(count(trace, Trace::Op::MUX), 0);
+  check_trace(trace);
+}
+
+TEST(BitTracker, lower_she) {
+  shared_ptr<BitTracker> tracker = make_shared<BitTrackerFHE>();
+  track_circuit(tracker);
+  tracker->lower(BitTracker::GateLib::SHE);
+
+  Trace trace = tracker->export_trace();
+  for (const Trace::Node &node : trace.nodes()) {
+    ASSERT_TRUE(node.op == Trace::Op::INPUT or node.op == Trace::Op::ZERO or
+                node.op == Trace::Op::ONE or node.op == Trace::Op::NOT or
+                node.op == Trace::Op::BUF or node.op == Trace::Op::AND or
+                node.op == Trace::Op::XOR);
+  }
+  check_trace(trace);
+}
+
+TEST(BitTracker, lower_fhe) {
+  shared_ptr<BitTracker> tracker = make_shared<BitTracker>();
+  track_circuit(tracker);
+
+  const unsigned cnt = bootstrap_count(tracker->export_trace());
+  tracker->lower(BitTracker::GateLib::FHE);
+
+  Trace trace = tracker->export_trace();
+  ASSERT_GT(count(trace, Trace::Op::MUX), 0);
+  ASSERT_LT(bootstrap_count(trace), cnt);
+  check_trace(trace);
+}
+
+TEST(BitTracker, simplify) {
+  BitTrackerFHE tracker;
+  ObjHandle a = tracker.encrypt(0);
+  ObjHandle b = tracker.encrypt(0);
+  ObjHandle zero = tracker.encode(0);
+  ObjHandle one = tracker.encode(1);
+
+  /* structural hashing, input order is normalized */
+  ASSERT_EQ(tracker.op_and(a, b), tracker.op_and(b, a));
+  ASSERT_EQ(tracker.op_andny(a, b), tracker.op_andyn(b, a));
+  ASSERT_NE(tracker.op_and(a, b), tracker.op_or(a, b));
+
+  /* identities */
+  ASSERT_EQ(tracker.op_and(a, one), a);
+  ASSERT_EQ(tracker.op_or(a, zero), a);
+  ASSERT_EQ(tracker.op_xor(a, zero), a);
+  ASSERT_EQ(tracker.op_and(a, a), a);
+  ASSERT_EQ(tracker.op_xor(a, one), tracker.op_not(a));
+  ASSERT_EQ(tracker.op_not(tracker.op_not(a)), a);
+  ASSERT_EQ(tracker.op_mux(zero, a, b), a);
+  ASSERT_EQ(tracker.op_mux(one, a, b), b);
+  ASSERT_EQ(tracker.op_mux(b, a, a), a);
+
+  /* constant results */
+  BitExecClear exec;
+  for (const ObjHandle &res :
+       {tracker.op_xor(a, a), tracker.op_and(a, zero),
+        tracker.op_and(a, tracker.op_not(a)), tracker.op_nor(a, one)}) {
+    tracker.decrypt(res);
+  }
+  Trace trace = tracker.export_trace();
+  vector<ObjHandle> outs = trace.replay(exec, {exec.encode(1), exec.encode(0)});
+  ASSERT_EQ(outs.size(), 4);
+  for (const ObjHandle &out : outs)
+    ASSERT_EQ(exec.decrypt(out) & 1, 0);
+}
+
+TEST(BitTracker, stream_blif) {
+  shared_ptr<BitTracker> tracker = make_shared<BitTrackerFHE>();
+  ostringstream blif;
+  tracker->stream_blif(blif, "test");
+
+  shared_ptr<IBitExec> bit_exec = CiContext::get_bit_exec();
+  shared_ptr<IIntOpGen> int_op_gen = CiContext::get_int_op_gen();
+  CiContext::set_config(tracker, make_shared<IntOpGenSize>());
+
+  CiInt a(0, 8, false);
+  CiInt b(0, 8, false);
+  a.read("a");
+  b.read("b");
+  CiInt c = select(a < b, a - b, a | ~b);
+  c.write("c");
+
+  CiContext::set_config(bit_exec, int_op_gen);
+  tracker->stream_end();
+
+  ASSERT_EQ(tracker->export_trace().nodes().size(), 0);
+
+  for (unsigned va = 0; va < 256; va += 23) {
+    for (unsigned vb = 0; vb < 256; vb += 19) {
+      map<string, bool> inps;
+      for (unsigned i = 0; i < 8; ++i) {
+        inps["i:a_" + to_string(i)] = (va >> i) & 1;
+        inps["i:b_" + to_string(i)] = (vb >> i) & 1;
+      }
+      map<string, bool> vals = eval_blif(blif.str(), inps);
+
+      unsigned val = 0;
+      for (unsigned i = 0; i < 8; ++i)
+        val |= vals.at("o:c_" + to_string(i)) << i;
+      ASSERT_EQ(val, expected(va, vb));
+    }
+  }
+}
+
+TEST(BitTracker, int_op_gen_cache) {
+  shared_ptr<BitTracker> tracker = make_shared<BitTracker>();
+  shared_ptr<IntOpGenCache<IntOpGenSize>> cache_gen =
+      make_shared<IntOpGenCache<IntOpGenSize>>();
+
+  shared_ptr<IBitExec> bit_exec = CiContext::get_bit_exec();
+  shared_ptr<IIntOpGen> int_op_gen = CiContext::get_int_op_gen();
+  CiContext::set_config(tracker, cache_gen);
+
+  /* first tracked node has the same index as plain-text 1 */
+  CiInt a(0, 8, false);
+  CiInt x(0, 8, false);
+  a.encrypt();
+  x.encrypt();
+  CiInt r1 = x + CiInt(1, 8, false);
+  CiInt r2 = x + (a & CiInt(1, 8, false));
+  ASSERT_EQ(cache_gen->cache().hits(), 0);
+  ASSERT_NE(r1[0].get_obj_handle(), r2[0].get_obj_handle());
+
+  /* node indices restart after reset */
+  ASSERT_GT(cache_gen->cache().size(), 0);
+  CiContext::reset();
+  ASSERT_EQ(cache_gen->cache().size(), 0);
+
+  CiContext::set_config(bit_exec, int_op_gen);
+}
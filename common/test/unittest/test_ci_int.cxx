@@ -19,6 +19,7 @@
 */
 
 #include <ci_context.hxx>
+#include <ci_fncs.hxx>
 #include <ci_int.hxx>
 
 #include <gtest/gtest.h>
@@ -664,6 +665,7 @@ TEST(CiInt, ror) {
  * Test operations based on IIntOpGen
  */
 
+#include <int_op_gen/cache.hxx>
 #include <int_op_gen/size.hxx>
 #include <int_op_gen/mult_depth.hxx>
 
@@ -682,7 +684,9 @@ protected:
 typedef ::testing::Types
 <
   IntOpGenSize,
-  IntOpGenDepth
+  IntOpGenDepth,
+  IntOpGenCache<IntOpGenSize>,
+  IntOpGenCache<IntOpGenDepth>
 >
 IntOpGenTypes;
 
@@ -758,6 +762,144 @@ OP_GEN_ARITH_2_INP( mul,
                     [] (const CiInt& a, const CiInt& b) -> CiInt {return a*b;},
                     [] (const long& a, const long& b) -> long {return a*b;});
 
+/**
+ * Test multiplication of wide integers and by plain-text constants
+ */
+TYPED_TEST(CiInt_OpGen, mul_wide) {
+  GEN_RAND_CI_L(x, rrand(40, 65), rand() % 2);
+  GEN_RAND_CI_L(y, x_size, x_is_signed);
+  CiInt r = x * y;
+  ASSERT_CI_PARAM(r, x_size, x_is_signed);
+  ASSERT_EQ_CI_L(r, (long)((unsigned long)x_val * y_val));
+}
+
+TYPED_TEST(CiInt_OpGen, mul_const) {
+  GEN_RAND_CI_L(x, rand() % 64 + 1, rand() % 2);
+  const long c_val = lrand();
+  const CiInt c(c_val, x_size, x_is_signed);
+  ASSERT_EQ_CI_L(x * c, (long)((unsigned long)x_val * c_val));
+  ASSERT_EQ_CI_L(c * x, (long)((unsigned long)x_val * c_val));
+  ASSERT_EQ_CI_L(x * CiInt(0L, x_size), 0L);
+  ASSERT_EQ_CI_L(x * CiInt(-1L, x_size), (long)(0UL - x_val));
+}
+
+/**
+ * Test table lookup with ciphertext index
+ */
+TYPED_TEST(CiInt_OpGen, lookup) {
+  GEN_RAND_CI_L(x, rand() % 6 + 1, false);
+  const unsigned m = rand() % 32 + 1;
+  const bool m_is_signed = rand() % 2;
+
+  vector<long> table_val;
+  vector<CiInt> table;
+  for (unsigned i = 0; i < (1U << x_size) - rand() % 2; ++i) {
+    table_val.push_back(lrand());
+    table.emplace_back(table_val.back(), m, m_is_signed);
+  }
+  table_val.resize(1U << x_size, 0);
+
+  CiInt r = lookup(x, table);
+  ASSERT_CI_PARAM(r, m, m_is_signed);
+  ASSERT_EQ_CI_L(r, table_val[x_val]);
+}
+
+/**
+ * Test table lookup with a wide index and a short table, out of range
+ * indices give zero
+ */
+TYPED_TEST(CiInt_OpGen, lookup_short_table) {
+  const unsigned n = rand() % 10 + 1;
+  const unsigned m = rand() % 16 + 1;
+
+  vector<long> table_val;
+  vector<CiInt> table;
+  for (unsigned i = 0; i < n; ++i) {
+    table_val.push_back(mod(lrand(), m));
+    table.emplace_back(table_val.back(), m, false);
+  }
+
+  for (const unsigned idx_size : {8U, 32U}) {
+    for (const unsigned long idx_val :
+         {0UL, (unsigned long)rand() % n, n - 1UL, (unsigned long)n, 16UL,
+          (1UL << (idx_size - 1)) + rand() % n, mod(lrand(), idx_size)}) {
+      CiInt x(idx_val, idx_size, false);
+      x.encrypt();
+
+      CiInt r = lookup(x, table);
+      ASSERT_CI_PARAM(r, m, false);
+      ASSERT_EQ_CI_L(r, idx_val < n ? table_val[idx_val] : 0);
+    }
+  }
+}
+
+/**
+ * Test population count
+ */
+TYPED_TEST(CiInt_OpGen, popcount) {
+  GEN_RAND_CI_L(x, rand() % 64 + 1, rand() % 2);
+  CiInt r = popcount(x);
+  ASSERT_EQ_CI_L(r, __builtin_popcountl(mod(x_val, x_size)));
+  ASSERT_FALSE(r.is_signed());
+
+  vector<CiBit> bits;
+  for (unsigned i = 0; i < x.size(); ++i)
+    bits.push_back(x[i]);
+  ASSERT_EQ_CI_L(sum(bits), __builtin_popcountl(mod(x_val, x_size)));
+  ASSERT_EQ(sum(vector<CiBit>()).size(), 0);
+}
+
+/**
+ * Test minimum, maximum and top-k selection
+ */
+TYPED_TEST(CiInt_OpGen, min_max) {
+  const unsigned n = rand() % 12 + 1;
+  const unsigned size = rand() % 16 + 1;
+  const bool is_signed = rand() % 2;
+
+  vector<CiInt> vals;
+  vector<long> vals_long;
+  for (unsigned i = 0; i < n; ++i) {
+    GEN_RAND_CI_L(x, size, is_signed);
+    vals.push_back(x);
+    vals_long.push_back(x_val);
+  }
+
+  const auto mn = min_element(vals_long.begin(), vals_long.end());
+  const auto mx = max_element(vals_long.begin(), vals_long.end());
+
+  CiInt r = min(vals);
+  ASSERT_CI_PARAM(r, size, is_signed);
+  ASSERT_EQ_CI_L(r, *mn);
+  ASSERT_EQ_CI_L(max(vals), *mx);
+  ASSERT_EQ_CI_L(argmin(vals), mn - vals_long.begin());
+  ASSERT_EQ_CI_L(argmax(vals), mx - vals_long.begin());
+
+  const unsigned k = rand() % (n + 1);
+  vector<long> sorted_long = vals_long;
+  sort(sorted_long.begin(), sorted_long.end(), greater<long>());
+  vector<CiInt> top = top_k(vals, k, true);
+  ASSERT_EQ(top.size(), k);
+  for (unsigned i = 0; i < k; ++i)
+    ASSERT_EQ_CI_L(top[i], sorted_long[i]);
+}
+
+/**
+ * Unqualified min/max calls on other types still resolve to the standard
+ * library functions, with both namespaces in scope
+ */
+TEST(CiInt, min_max_std_overloads) {
+  static_assert(is_same<decltype(min(1, 2)), const int &>::value, "");
+  static_assert(is_same<decltype(max(1u, 2u)), const unsigned &>::value, "");
+  static_assert(is_same<decltype(min({1, 2})), int>::value, "");
+  static_assert(is_same<decltype(max(vector<CiInt>())), CiInt>::value, "");
+
+  ASSERT_EQ(min(7, -3), -3);
+  ASSERT_EQ(max(4ul, 9ul), 9ul);
+  ASSERT_EQ(min({5, 2, 8}), 2);
+  ASSERT_EQ(max({5, 2, 8}), 8);
+}
+
 /**
  * Test comparison operators applied on same input
  */
@@ -834,3 +976,157 @@ OP_GEN_COMP_2_INP(  DISABLED_greater,
 OP_GEN_COMP_2_INP(  DISABLED_greater_equal,
                     [] (const CiInt& a, const CiInt& b) -> CiBit {return a >= b;},
                     [] (const long& a, const long& b) -> bool {return a >= b;});
+
+/**
+ * Test division operators, divisor is not zero
+ */
+#define OP_GEN_DIV(TEST_NAME, OPER_CT, OPER_PT)                                \
+  TYPED_TEST(CiInt_OpGen, TEST_NAME) {                                         \
+    for (unsigned iter = 0; iter < 4; ++iter) {                                \
+      GEN_RAND_CI_L(x, rand() % 24 + 1, rand() % 2);                           \
+      unsigned y_size = rand() % 24 + 1;                                       \
+      bool y_is_signed = rand() % 2;                                           \
+      long y_val = mod(lrand(), y_size) >> (rand() % y_size);                  \
+      if (y_val == 0)                                                          \
+        y_val = 1;                                                             \
+      if (y_is_signed and (y_val >> (y_size - 1)))                             \
+        y_val -= 1L << y_size;                                                 \
+      CiInt y(y_val, y_size, y_is_signed);                                     \
+      y.encrypt();                                                             \
+      unsigned r_size = max(x_size, y_size);                                   \
+      bool r_is_signed = (x_size == y_size)                                    \
+                             ? (x_is_signed and y_is_signed)                   \
+                             : (x_size > y_size ? x_is_signed : y_is_signed);  \
+      /* operand values seen as result type */                                 \
+      auto as_res = [&](long v) {                                              \
+        v = mod(v, r_size);                                                    \
+        if (r_is_signed and (v >> (r_size - 1)))                               \
+          v -= 1L << r_size;                                                   \
+        return v;                                                              \
+      };                                                                       \
+      if (as_res(y_val) == 0)                                                  \
+        continue;                                                              \
+      CiInt r = OPER_CT(x, y);                                                 \
+      ASSERT_CI_PARAM(x, x_size, x_is_signed);                                 \
+      ASSERT_EQ_CI_L(x, x_val);                                                \
+      ASSERT_CI_PARAM(y, y_size, y_is_signed);                                 \
+      ASSERT_EQ_CI_L(y, y_val);                                                \
+      ASSERT_CI_PARAM(r, r_size, r_is_signed);                                 \
+      ASSERT_EQ_CI_L(r, OPER_PT(as_res(x_val), as_res(y_val)));                \
+    }                                                                          \
+  }
+
+OP_GEN_DIV(         div,
+                    [] (const CiInt& a, const CiInt& b) -> CiInt {return a/b;},
+                    [] (const long& a, const long& b) -> long {return a/b;});
+
+OP_GEN_DIV(         mod,
+                    [] (const CiInt& a, const CiInt& b) -> CiInt {return a%b;},
+                    [] (const long& a, const long& b) -> long {return a%b;});
+
+/**
+ * Test shift/rotate by ciphertext amount
+ */
+#define OP_GEN_SHIFT(TEST_NAME, OPER_CT, OPER_PT)                              \
+  TYPED_TEST(CiInt_OpGen, TEST_NAME) {                                         \
+    GEN_RAND_CI_L(x, rand() % 32 + 1, rand() % 2);                             \
+    GEN_RAND_CI_L(p, rand() % 6 + 1, false);                                   \
+    CiInt r = OPER_CT(x, p);                                                   \
+    ASSERT_CI_PARAM(x, x_size, x_is_signed);                                   \
+    ASSERT_EQ_CI_L(x, x_val);                                                  \
+    ASSERT_CI_PARAM(r, x_size, x_is_signed);                                   \
+    ASSERT_EQ_CI_L(r, OPER_PT(x_val, x_size, p_val));                          \
+  }
+
+OP_GEN_SHIFT(       shl_ct,
+                    [] (const CiInt& a, const CiInt& p) -> CiInt {return a << p;},
+                    [] (long a, unsigned n, long p) -> long {return (unsigned long)a << p;});
+
+OP_GEN_SHIFT(       shr_ct,
+                    [] (const CiInt& a, const CiInt& p) -> CiInt {return a >> p;},
+                    [] (long a, unsigned n, long p) -> long {return a >> p;});
+
+OP_GEN_SHIFT(       rol_ct,
+                    [] (const CiInt& a, const CiInt& p) -> CiInt {return rol(a, p);},
+                    [] (long a, unsigned n, long p) -> long {
+                      unsigned long u = mod(a, n);
+                      return (u << (p % n)) | (u >> (n - p % n));
+                    });
+
+OP_GEN_SHIFT(       ror_ct,
+                    [] (const CiInt& a, const CiInt& p) -> CiInt {return ror(a, p);},
+                    [] (long a, unsigned n, long p) -> long {
+                      unsigned long u = mod(a, n);
+                      return (u >> (p % n)) | (u << (n - p % n));
+                    });
+
+/**
+ * Test common sub-expression elimination of memoized operations
+ */
+TEST(IntOpGenCache, same_inputs) {
+  auto gen = make_shared<IntOpGenCache<IntOpGenDepth>>();
+  CiContext::set_int_op_gen(gen);
+
+  GEN_RAND_CI_L(x, rand() % 32 + 1, false);
+  GEN_RAND_CI_L(y, x_size, false);
+
+  /* swapped or commutative inputs give same bits */
+  CiBit r1 = x < y;
+  CiBit r2 = y > x;
+  ASSERT_EQ(r1.get_obj_handle(), r2.get_obj_handle());
+
+  CiInt s1 = x + y;
+  CiInt s2 = y + x;
+  for (unsigned i = 0; i < x_size; ++i)
+    ASSERT_EQ(s1[i].get_obj_handle(), s2[i].get_obj_handle());
+  ASSERT_EQ_CI_L(s1, x_val + y_val);
+
+  /* different inputs are not mixed */
+  CiInt d1 = x - y;
+  CiInt d2 = y - x;
+  ASSERT_EQ_CI_L(d1, x_val - y_val);
+  ASSERT_EQ_CI_L(d2, y_val - x_val);
+
+  ASSERT_GE(gen->cache().hits(), 2);
+  gen->cache().clear();
+  ASSERT_EQ(gen->cache().size(), 0);
+
+  CiContext::clear_int_op_gen();
+}
+
+TEST(IntOpGenCache, capacity) {
+  OpCache cache(2);
+  unsigned calls = 0;
+  auto fnc = [&]() -> OpCache::Result {
+    calls++;
+    return {CiBitVector(1, CiBit::one)};
+  };
+
+  const CiBitVector a(4, CiBit::zero);
+  const CiBitVector b(4, CiBit::one);
+  const CiBitVector c(5, CiBit::zero);
+
+  cache.get("op", {a}, fnc);
+  cache.get("op", {b}, fnc);
+  cache.get("op", {a}, fnc);
+  ASSERT_EQ(calls, 2);
+
+  /* least recently used entry (b) is evicted */
+  cache.get("op", {c}, fnc);
+  ASSERT_EQ(cache.size(), 2);
+  cache.get("op", {a}, fnc);
+  ASSERT_EQ(calls, 3);
+  cache.get("op", {b}, fnc);
+  ASSERT_EQ(calls, 4);
+
+  cache.set_capacity(1);
+  ASSERT_EQ(cache.size(), 1);
+  cache.get("op", {b}, fnc);
+  ASSERT_EQ(calls, 4);
+
+  /* zero capacity disables caching */
+  cache.set_capacity(0);
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_EQ(cache.get("op", {b}, fnc).size(), 1);
+  ASSERT_EQ(calls, 5);
+}
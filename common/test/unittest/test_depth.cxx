@@ -0,0 +1,133 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <bit_exec/decorator/attach.hxx>
+#include <bit_exec/decorator/depth.hxx>
+#include <bit_exec/tracker.hxx>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace cingulata;
+
+TEST(DepthDecorator, report) {
+  typedef decorator::Depth<IBitExecSHE> Depth;
+  decorator::Attach<BitTracker, Depth> exec;
+
+  ObjHandle a = exec.read("a");
+  ObjHandle b = exec.read("b");
+  ObjHandle c = exec.read("c");
+
+  ObjHandle x = exec.op_xor(exec.op_and(a, b), c);
+  exec.begin_section("sec");
+  ObjHandle z = exec.op_xor(exec.op_and(x, a), b);
+  exec.end_section();
+
+  exec.write(x, "x");
+  exec.write(z, "z");
+
+  EXPECT_EQ(exec.mult_depth(), 2u);
+  EXPECT_EQ(exec.depth(), 4u);
+
+  ASSERT_EQ(exec.output_depths().size(), 2u);
+  EXPECT_EQ(exec.output_depths()[0].name, "x");
+  EXPECT_EQ(exec.output_depths()[0].mult_depth, 1u);
+  EXPECT_EQ(exec.output_depths()[0].depth, 2u);
+  EXPECT_EQ(exec.output_depths()[1].mult_depth, 2u);
+  EXPECT_EQ(exec.output_depths()[1].depth, 4u);
+
+  ASSERT_EQ(exec.section_depths().size(), 1u);
+  EXPECT_EQ(exec.section_depths()[0].name, "sec");
+  EXPECT_EQ(exec.section_depths()[0].mult_depth, 2u);
+  EXPECT_EQ(exec.section_depths()[0].gate_cnt, 2u);
+
+  const vector<Depth::Gate> path = exec.critical_path();
+  const vector<Depth::Op> ops = {Depth::Op::INPUT, Depth::Op::AND,
+                                 Depth::Op::XOR, Depth::Op::AND,
+                                 Depth::Op::XOR};
+  ASSERT_EQ(path.size(), ops.size());
+  for (unsigned i = 0; i < path.size(); ++i) {
+    EXPECT_EQ(path[i].op, ops[i]);
+    EXPECT_EQ(path[i].depth, i);
+  }
+
+  stringstream json;
+  exec.export_json(json);
+  EXPECT_NE(json.str().find("\"mult_depth\": 2,"), string::npos);
+  EXPECT_NE(json.str().find("{\"op\": \"INPUT\", \"name\": \"a\""), string::npos);
+}
+
+TEST(DepthDecorator, existing_handles) {
+  typedef decorator::Depth<IBitExecSHE> Depth;
+  decorator::Attach<BitTracker, Depth> exec;
+
+  ObjHandle a = exec.read("a");
+  ObjHandle b = exec.read("b");
+
+  /* double negation is simplified to an existing node */
+  ObjHandle x = exec.op_and(a, b);
+  ASSERT_EQ(exec.op_not(exec.op_not(x)), x);
+  exec.write(x, "x");
+
+  ASSERT_EQ(exec.output_depths().size(), 1u);
+  EXPECT_EQ(exec.output_depths()[0].mult_depth, 1u);
+  EXPECT_EQ(exec.output_depths()[0].depth, 1u);
+
+  /* streamed node slots are reused by new nodes */
+  ostringstream blif;
+  exec.stream_blif(blif);
+  a = exec.read("a");
+  b = exec.read("b");
+  ObjHandle c = exec.read("c");
+  {
+    ObjHandle t = exec.op_and(exec.op_and(a, b), exec.op_and(a, c));
+    exec.write(t, "t");
+  }
+  ObjHandle y = exec.op_xor(a, b);
+  exec.write(y, "y");
+
+  ASSERT_EQ(exec.output_depths().size(), 2u);
+  EXPECT_EQ(exec.output_depths()[0].mult_depth, 2u);
+  EXPECT_EQ(exec.output_depths()[1].mult_depth, 0u);
+  EXPECT_EQ(exec.output_depths()[1].depth, 1u);
+  exec.stream_end();
+}
+
+TEST(DepthDecorator, constant_results) {
+  typedef decorator::Depth<IBitExecSHE> Depth;
+  decorator::Attach<BitTracker, Depth> exec;
+
+  ObjHandle a = exec.read("a");
+  ObjHandle b = exec.read("b");
+  ObjHandle x = exec.op_and(a, b);
+
+  exec.write(exec.op_xor(x, x), "x^x");
+  exec.write(exec.op_and(x, exec.op_not(x)), "x&~x");
+  exec.write(exec.op_or(exec.op_not(x), x), "~x|x");
+  exec.write(exec.op_and(x, exec.encode(0)), "x&0");
+
+  for (const Depth::Record &rec : exec.output_depths()) {
+    EXPECT_EQ(rec.mult_depth, 0u) << rec.name;
+    EXPECT_EQ(rec.depth, 0u) << rec.name;
+  }
+  EXPECT_EQ(exec.output_depths().size(), 4u);
+}
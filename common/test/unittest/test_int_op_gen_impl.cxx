@@ -20,6 +20,8 @@
 
 #include <int_op_gen/impl/all.hxx>
 #include <cmath>
+#include <thread>
+#include <typeinfo>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -43,6 +45,14 @@ T to_binary(unsigned val, int n) {
   unsigned VAR##_int = mod(val, n);                                            \
   CiBitVector VAR##_bv = to_binary<CiBitVector>((VAR##_int), (n)).encrypt();
 
+/* plain-text bits with random positions encrypted */
+#define GEN_RAND_MIXED_BV(VAR, n, val)                                         \
+  unsigned VAR##_int = mod(val, n);                                            \
+  CiBitVector VAR##_bv = to_binary<CiBitVector>((VAR##_int), (n));             \
+  for (unsigned VAR##_i = 0; VAR##_i < (n); ++VAR##_i)                         \
+    if (rand() % 2)                                                            \
+      VAR##_bv[VAR##_i].encrypt();
+
 #define ASSERT_EQ_BV_INT(ct_vec1, pt_int)                                      \
   {                                                                            \
     CiBitVector ct_vec = (ct_vec1);                                            \
@@ -101,6 +111,64 @@ TEST(IntOpGen, Mux) {
 
   /* output is valid */
   ASSERT_EQ_BV_INT(out, vals_m_int[cond_int]);
+
+  /* plain-text condition */
+  CiBitVector cond_pt = to_binary<CiBitVector>(cond_int, logn);
+  ASSERT_EQ_BV_INT(MuxDepth()(cond_pt, vals_m_bv), vals_m_int[cond_int]);
+}
+
+TEST(IntOpGen, LookupAnf) {
+  const unsigned logn = (rand()%8)+1;
+  const unsigned n = 1 << logn;
+  const unsigned m = rand() % 32;
+
+  vector<unsigned> vals_m_int;
+  vector<CiBitVector> vals_m_pt;
+  vector<CiBitVector> vals_m_bv;
+
+  for (unsigned i = 0; i < n; ++i) {
+    GEN_RAND_BV(tmp, m, rand());
+    vals_m_int.push_back(tmp_int);
+    vals_m_pt.push_back(to_binary<CiBitVector>(tmp_int, m));
+    vals_m_bv.push_back(tmp_bv);
+  }
+
+  GEN_RAND_BV(cond, logn, rand());
+
+  /* plain-text table */
+  ASSERT_EQ_BV_INT(LookupAnf()(cond_bv, vals_m_pt), vals_m_int[cond_int]);
+
+  /* ciphered table */
+  ASSERT_EQ_BV_INT(LookupAnf()(cond_bv, vals_m_bv), vals_m_int[cond_int]);
+
+  /* inputs did not changed */
+  ASSERT_EQ_BV_INT(cond_bv, cond_int);
+  for (int i = 0; i < n; ++i) {
+    ASSERT_EQ_BV_INT(vals_m_bv[i], vals_m_int[i]);
+  }
+}
+
+TEST(IntOpGen, PopCount) {
+  const unsigned n = rand() % 100 + 1;
+
+  /* plain-text bits with random positions encrypted */
+  CiBitVector inp(n);
+  unsigned cnt = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    inp[i] = rand() % 2;
+    cnt += inp[i].get_val();
+    if (rand() % 4)
+      inp[i].encrypt();
+  }
+
+  CiBitVector out = PopCount()(inp);
+
+  unsigned size = 1;
+  while (n >> size)
+    size++;
+
+  ASSERT_LE(out.size(), size);
+  ASSERT_EQ_BV_INT(out.resize(size), cnt);
 }
 
 TEST(IntOpGen, Sort_same) {
@@ -123,12 +191,135 @@ TEST(IntOpGen, Sort_same) {
   else
     sort(vals_int.begin(), vals_int.end(), greater<int>());
 
-  vector<CiBitVector> out = SortDepth(LowerCompSize(), EqualSize(), SklanskyAdder())(vals_bv, r);
+  vector<CiBitVector> out = SortDepth(LowerCompSize(), EqualSize(), PopCount())(vals_bv, r);
   for (int i = 0; i < size_array; ++i) {
     ASSERT_EQ_BV_INT(out[i], vals_int[i]);
   }
 }
 
+TEST(IntOpGen, SortSize_networks) {
+  /* 0-1 principle: a network sorts if it sorts all binary inputs */
+  for (const auto network : {SortSize::Network::ODD_EVEN_MERGE,
+                             SortSize::Network::BITONIC}) {
+    const SortSize sorter(LowerCompSize(), network);
+    for (unsigned n = 1; n <= 12; ++n) {
+      const auto cmp_exchs = sorter.comparators(n);
+      for (unsigned inp = 0; inp < (1U << n); ++inp) {
+        unsigned val = inp;
+        for (const auto &ce : cmp_exchs) {
+          const unsigned a = (val >> ce.first) & 1;
+          const unsigned b = (val >> ce.second) & 1;
+          if (a > b)
+            val ^= (1U << ce.first) | (1U << ce.second);
+        }
+        /* sorted binary word has all ones on top */
+        const unsigned ones = __builtin_popcount(inp);
+        ASSERT_EQ(val, ((1U << ones) - 1) << (n - ones)) << "n: " << n;
+      }
+    }
+  }
+}
+
+TEST(IntOpGen, SortSize) {
+  for (const auto network : {SortSize::Network::ODD_EVEN_MERGE,
+                             SortSize::Network::BITONIC}) {
+    const unsigned size_array = rand() % 20 + 1;
+    const unsigned m = rand() % 8 + 1;
+    const bool r = rand() % 2;
+
+    vector<pair<unsigned, unsigned>> elems;
+    vector<CiBitVector> keys_bv, vals_bv;
+    for (unsigned i = 0; i < size_array; ++i) {
+      GEN_RAND_BV(key, m, rand());
+      GEN_RAND_BV(val, 12, rand());
+      elems.emplace_back(key_int, val_int);
+      keys_bv.push_back(key_bv);
+      vals_bv.push_back(val_bv);
+    }
+
+    const SortSize sorter(LowerCompDepth(), network);
+    vector<CiBitVector> keys_out = sorter(keys_bv, r);
+    vector<CiBitVector> vals_out = sorter(keys_bv, vals_bv, r);
+
+    /* inputs did not changed */
+    for (unsigned i = 0; i < size_array; ++i) {
+      ASSERT_EQ_BV_INT(keys_bv[i], elems[i].first);
+      ASSERT_EQ_BV_INT(vals_bv[i], elems[i].second);
+    }
+
+    /* keys are sorted, values follow their keys */
+    stable_sort(elems.begin(), elems.end(),
+                [r](const pair<unsigned, unsigned> &a,
+                    const pair<unsigned, unsigned> &b) {
+                  return r ? a.first > b.first : a.first < b.first;
+                });
+    vector<unsigned> vals_dec;
+    for (unsigned i = 0; i < size_array; ++i) {
+      ASSERT_EQ_BV_INT(keys_out[i], elems[i].first);
+      CiBitVector val = vals_out[i];
+      val.decrypt();
+      unsigned v = 0;
+      for (unsigned j = 0; j < val.size(); ++j)
+        v |= val[j].get_val() << j;
+      vals_dec.push_back(v);
+    }
+    for (unsigned i = 0; i < size_array;) {
+      unsigned j = i;
+      vector<unsigned> exp_vals;
+      while (j < size_array and elems[j].first == elems[i].first)
+        exp_vals.push_back(elems[j++].second);
+      ASSERT_THAT(vector<unsigned>(vals_dec.begin() + i, vals_dec.begin() + j),
+                  ::testing::UnorderedElementsAreArray(exp_vals));
+      i = j;
+    }
+  }
+}
+
+TEST(IntOpGen, TopK) {
+  const unsigned size_array = rand() % 40 + 1;
+  const unsigned m = rand() % 8 + 1;
+  const unsigned k = rand() % (size_array + 2);
+  const bool r = rand() % 2;
+
+  vector<unsigned> keys_int;
+  vector<CiBitVector> keys_bv, idx_bv;
+  for (unsigned i = 0; i < size_array; ++i) {
+    GEN_RAND_BV(key, m, rand());
+    keys_int.push_back(key_int);
+    keys_bv.push_back(key_bv);
+    idx_bv.push_back(to_binary<CiBitVector>(i, 6));
+  }
+
+  const TopK top_k{LowerCompDepth()};
+  vector<CiBitVector> keys_out = top_k(keys_bv, keys_bv, k, r);
+  vector<CiBitVector> idx_out = top_k(keys_bv, idx_bv, k, r);
+
+  vector<unsigned> keys_sorted = keys_int;
+  if (r == 0)
+    sort(keys_sorted.begin(), keys_sorted.end());
+  else
+    sort(keys_sorted.begin(), keys_sorted.end(), greater<unsigned>());
+
+  /* keys are the first sorted ones, indices are distinct and match keys */
+  const unsigned n = min(k, size_array);
+  ASSERT_EQ(keys_out.size(), n);
+  ASSERT_EQ(idx_out.size(), n);
+  vector<unsigned> idx_dec;
+  for (unsigned i = 0; i < n; ++i) {
+    ASSERT_EQ_BV_INT(keys_out[i], keys_sorted[i]);
+    CiBitVector idx = idx_out[i];
+    idx.decrypt();
+    unsigned v = 0;
+    for (unsigned j = 0; j < idx.size(); ++j)
+      v |= idx[j].get_val() << j;
+    ASSERT_LT(v, size_array);
+    ASSERT_EQ(keys_int[v], keys_sorted[i]);
+    idx_dec.push_back(v);
+  }
+  sort(idx_dec.begin(), idx_dec.end());
+  ASSERT_EQ(unique(idx_dec.begin(), idx_dec.end()), idx_dec.end());
+}
+
 /*-------------------------------------------------------------------------*/
 /**
  * Multiple implementations operators
@@ -201,6 +392,18 @@ TEST_P(Adder, zero_and_randomom_inp) {
   TEST_ADDER_OP(b_int, b_bv, a_int, a_bv, (bool)c_int, c_bv.at(0));
 }
 
+TEST_P(Adder, plain_inps) {
+  const unsigned n = rand() % 32 + 1;
+
+  /* low and high plain-text bits are handled by base class */
+  GEN_RAND_MIXED_BV(a, n, rand() >> (rand() % 32));
+  GEN_RAND_MIXED_BV(b, n, rand() >> (rand() % 32));
+  GEN_RAND_MIXED_BV(c, 1, rand()%2)
+
+  TEST_ADDER_OP(a_int, a_bv, b_int, b_bv, (bool)c_int, c_bv.at(0));
+  TEST_ADDER_OP(b_int, b_bv, a_int, a_bv, (bool)c_int, c_bv.at(0));
+}
+
 TEST_P(Adder, 1bit_randomom_inps) {
   const unsigned n = 1;
 
@@ -229,8 +432,43 @@ AdderParam adder_params[] =
       return SklanskyAdder()(a,b,carry_in);
     },
     [](const unsigned a, const unsigned b, const bool c) -> unsigned {
-      return a + b + 0U; // TODO: add carry in to Sklansky adder
-      // return a + b + (c ? 1U : 0U);
+      return a + b + (c ? 1U : 0U);
+    }
+  },
+  {
+    "KoggeStoneAdder",
+    [](const CiBitVector& a, const CiBitVector& b, const CiBit& carry_in) -> CiBitVector {
+      return KoggeStoneAdder()(a,b,carry_in);
+    },
+    [](const unsigned a, const unsigned b, const bool c) -> unsigned {
+      return a + b + (c ? 1U : 0U);
+    }
+  },
+  {
+    "BrentKungAdder",
+    [](const CiBitVector& a, const CiBitVector& b, const CiBit& carry_in) -> CiBitVector {
+      return BrentKungAdder()(a,b,carry_in);
+    },
+    [](const unsigned a, const unsigned b, const bool c) -> unsigned {
+      return a + b + (c ? 1U : 0U);
+    }
+  },
+  {
+    "HanCarlsonAdder",
+    [](const CiBitVector& a, const CiBitVector& b, const CiBit& carry_in) -> CiBitVector {
+      return HanCarlsonAdder()(a,b,carry_in);
+    },
+    [](const unsigned a, const unsigned b, const bool c) -> unsigned {
+      return a + b + (c ? 1U : 0U);
+    }
+  },
+  {
+    "CostModelAdder",
+    [](const CiBitVector& a, const CiBitVector& b, const CiBit& carry_in) -> CiBitVector {
+      return CostModelAdder(1, 1000)(a,b,carry_in);
+    },
+    [](const unsigned a, const unsigned b, const bool c) -> unsigned {
+      return a + b + (c ? 1U : 0U);
     }
   }
 };
@@ -242,6 +480,55 @@ INSTANTIATE_TEST_CASE_P(
   get_oper_name<AdderParam>
 );
 
+TEST(IntOpGen, CostModelAdder) {
+  const RippleCarryAdder ripple_carry;
+  const SklanskyAdder sklansky;
+  const KoggeStoneAdder kogge_stone;
+
+  for (unsigned n = 1; n <= 64; ++n) {
+    /* ripple-carry adder has the fewest AND gates */
+    const CostModelAdder size_adder(1, 0);
+    ASSERT_NE(dynamic_cast<const RippleCarryAdder *>(&size_adder.select(n)),
+              nullptr);
+
+    /* Kogge-Stone adder has the lowest depth */
+    const CostModelAdder depth_adder(1, 1000);
+    const AdderOper &adder = depth_adder.select(n);
+    auto cost = [&](const AdderOper &op) {
+      auto rca = dynamic_cast<const RippleCarryAdder *>(&op);
+      return rca ? rca->cost(n) : dynamic_cast<const PrefixAdder &>(op).cost(n);
+    };
+    ASSERT_EQ(cost(adder).second, min(ripple_carry.cost(n).second,
+                                      kogge_stone.cost(n).second));
+    ASSERT_LE(cost(adder).second, sklansky.cost(n).second);
+  }
+}
+
+TEST(IntOpGen, CostModelAdder_concurrent_select) {
+  const CostModelAdder adder(1, 10);
+  const CostModelAdder ref_adder(1, 10);
+
+  /* threads fill the selection cache of the same adder concurrently */
+  vector<vector<const AdderOper *>> sel(4);
+  vector<thread> threads;
+  for (unsigned t = 0; t < sel.size(); ++t) {
+    threads.emplace_back([&adder, &sel, t]() {
+      for (unsigned n = 1; n <= 128; ++n)
+        sel[t].push_back(&adder.select((n * (t + 1) * 37) % 128 + 1));
+    });
+  }
+  for (thread &th : threads)
+    th.join();
+
+  for (unsigned t = 0; t < sel.size(); ++t) {
+    for (unsigned n = 1; n <= 128; ++n) {
+      const unsigned size = (n * (t + 1) * 37) % 128 + 1;
+      ASSERT_EQ(sel[t][n - 1], &adder.select(size));
+      ASSERT_EQ(typeid(*sel[t][n - 1]), typeid(ref_adder.select(size)));
+    }
+  }
+}
+
 
 /*-------------------------------------------------------------------------*/
 /**
@@ -322,6 +609,41 @@ BinaryParam binary_params[] =
     [](const unsigned a, const unsigned b) -> unsigned {
       return a * b;
     }
+  },
+  {
+    "DaddaMultiplier",
+    [](const CiBitVector& a, const CiBitVector& b) -> CiBitVector {
+      return DaddaMultiplier(RippleCarryAdder())(a,b);
+    },
+    [](const unsigned a, const unsigned b) -> unsigned {
+      return a * b;
+    }
+  },
+  {
+    "KaratsubaMultiplier",
+    [](const CiBitVector& a, const CiBitVector& b) -> CiBitVector {
+      const RippleCarryAdder adder;
+      return KaratsubaMultiplier(
+        adder,
+        [&adder](const CiBitVector& x, const CiBitVector& y) {
+          return adder(x, ~y, CiBit::one);
+        },
+        DaddaMultiplier(adder), 4)(a,b);
+    },
+    [](const unsigned a, const unsigned b) -> unsigned {
+      return a * b;
+    }
+  },
+  {
+    "ConstMultiplier",
+    [](const CiBitVector& a, const CiBitVector& b) -> CiBitVector {
+      CiBitVector b_pt = b;
+      b_pt.decrypt();
+      return ConstMultiplier(SklanskyAdder())(a,b_pt);
+    },
+    [](const unsigned a, const unsigned b) -> unsigned {
+      return a * b;
+    }
   }
 };
 
@@ -392,6 +714,18 @@ TEST_P(Comparator, zero_and_randomom_inp) {
   TEST_COMP_OP(b_int, b_bv, a_int, a_bv);
 }
 
+TEST_P(Comparator, plain_inps) {
+  const unsigned n = rand() % 32 + 1;
+
+  /* inputs differ on few bits, some of them plain-text */
+  GEN_RAND_MIXED_BV(a, n, rand());
+  GEN_RAND_MIXED_BV(b, n, a_int ^ (rand() & rand() & rand()));
+
+  TEST_COMP_OP(a_int, a_bv, b_int, b_bv);
+  TEST_COMP_OP(b_int, b_bv, a_int, a_bv);
+  TEST_COMP_OP(a_int, a_bv, a_int, a_bv);
+}
+
 TEST_P(Comparator, 1bit_randomom_inps) {
   const unsigned n = 1;
 
@@ -425,7 +759,7 @@ ComparatorParam comp_params[] =
   {
     "LowerCompDepth",
     [](const CiBitVector& a, const CiBitVector& b) -> CiBit {
-      return LowerCompDepth(EqualSize())(a,b);
+      return LowerCompDepth()(a,b);
     },
     [](const unsigned a, const unsigned b) -> bool {
       return a < b;
@@ -606,3 +940,99 @@ TEST(MultiInputAdder, diff_size) {
   ASSERT_EQ(out_bv.size(), out_size) << " n: " << n << " logn: " << logn;
 
 }
+
+/*-------------------------------------------------------------------------*/
+/**
+ * Shift and division operators tests
+ */
+/*-------------------------------------------------------------------------*/
+
+unsigned shift_pt(const unsigned val, const unsigned pos, const unsigned n,
+                  const ShiftOper::Mode mode, const bool fill) {
+  const unsigned ones = mod(-1U, n);
+  const unsigned fill_bits = fill ? ones : 0;
+  switch (mode) {
+    case ShiftOper::Mode::SHL:
+      return pos >= n ? fill_bits : mod((val << pos) | (fill_bits >> (n - pos)), n);
+    case ShiftOper::Mode::SHR:
+      return pos >= n ? fill_bits : (val >> pos) | mod(fill_bits << (n - pos), n);
+    case ShiftOper::Mode::ROL:
+      return mod((val << (pos % n)) | (val >> (n - pos % n)), n);
+    default:
+      return mod((val >> (pos % n)) | (val << (n - pos % n)), n);
+  }
+}
+
+void test_shift(const ShiftOper& oper) {
+  const ShiftOper::Mode modes[] = {ShiftOper::Mode::SHL, ShiftOper::Mode::SHR,
+                                   ShiftOper::Mode::ROL, ShiftOper::Mode::ROR};
+  const unsigned n = rand() % 24 + 1;
+  const unsigned m = rand() % 7 + 1;
+  GEN_RAND_BV(a, n, rand());
+  GEN_RAND_BV(pos, m, rand());
+
+  for (const ShiftOper::Mode mode : modes) {
+    const bool fill = rand() % 2;
+    CiBitVector r_bv = oper(a_bv, pos_bv, mode, CiBit(fill));
+
+    /* inputs did not changed */
+    ASSERT_EQ_BV_INT(a_bv, a_int);
+    ASSERT_EQ_BV_INT(pos_bv, pos_int);
+
+    /* output is valid */
+    SCOPED_TRACE("mode " + to_string((int)mode));
+    ASSERT_EQ(r_bv.size(), n);
+    ASSERT_EQ_BV_INT(r_bv, shift_pt(a_int, pos_int, n, mode, fill));
+
+    /* plain-text amount */
+    CiBitVector pos_pt = to_binary<CiBitVector>(pos_int, m);
+    ASSERT_EQ_BV_INT(oper(a_bv, pos_pt, mode, CiBit(fill)),
+                     shift_pt(a_int, pos_int, n, mode, fill));
+  }
+}
+
+TEST(IntOpGen, ShiftSize) {
+  for (unsigned i = 0; i < 8; ++i)
+    test_shift(ShiftSize());
+}
+
+TEST(IntOpGen, ShiftDepth) {
+  for (unsigned i = 0; i < 8; ++i)
+    test_shift(ShiftDepth());
+}
+
+void test_divider(const DivOper& oper) {
+  const unsigned n = rand() % 16 + 1;
+  GEN_RAND_BV(a, n, rand());
+  GEN_RAND_BV(b, n, rand() >> (rand() % n));
+
+  auto res = oper(a_bv, b_bv);
+
+  /* inputs did not changed */
+  ASSERT_EQ_BV_INT(a_bv, a_int);
+  ASSERT_EQ_BV_INT(b_bv, b_int);
+
+  /* output is valid, division by zero gives all ones and dividend */
+  ASSERT_EQ(res.first.size(), n);
+  ASSERT_EQ(res.second.size(), n);
+  ASSERT_EQ_BV_INT(res.first, b_int ? a_int / b_int : mod(-1U, n));
+  ASSERT_EQ_BV_INT(res.second, b_int ? a_int % b_int : a_int);
+}
+
+TEST(IntOpGen, DividerSize) {
+  DividerSize divider([](const CiBitVector& a, const CiBitVector& b) {
+    return RippleCarryAdder()(a, ~b, CiBit::one);
+  });
+  for (unsigned i = 0; i < 8; ++i)
+    test_divider(divider);
+}
+
+TEST(IntOpGen, DividerDepth) {
+  DividerDepth divider(
+      [](const CiBitVector& a, const CiBitVector& b) {
+        return SklanskyAdder()(a, Negate(SklanskyAdder())(b));
+      },
+      LowerCompDepth());
+  for (unsigned i = 0; i < 8; ++i)
+    test_divider(divider);
+}
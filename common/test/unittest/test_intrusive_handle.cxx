@@ -0,0 +1,124 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <bit_exec/intrusive_handle.hxx>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace cingulata::intrusive;
+
+namespace {
+/**
+ * @brief      Deleter counting deleted objects
+ */
+struct CountDel {
+  atomic<unsigned> *cnt;
+  void operator()(void *ptr) const {
+    delete static_cast<int *>(ptr);
+    (*cnt)++;
+  }
+};
+
+typedef HandleT<int> Handle;
+typedef DelCtrlBlock<CountDel> Block;
+} // namespace
+
+TEST(IntrusiveHandle, ref_count) {
+  atomic<unsigned> del_cnt(0);
+  {
+    Handle a(new int(1), CountDel{&del_cnt});
+    EXPECT_EQ(a.use_count(), 1);
+    {
+      Handle b(a);
+      Handle c;
+      c = b;
+      EXPECT_EQ(a.use_count(), 3);
+      EXPECT_EQ(*c, 1);
+      EXPECT_TRUE(a == c);
+    }
+    EXPECT_EQ(a.use_count(), 1);
+    EXPECT_EQ(del_cnt, 0u);
+  }
+  EXPECT_EQ(del_cnt, 1u);
+
+  Handle d(new int(2), CountDel{&del_cnt});
+  d.reset();
+  EXPECT_FALSE(d);
+  EXPECT_EQ(d.use_count(), 0);
+  EXPECT_EQ(del_cnt, 2u);
+}
+
+TEST(IntrusiveHandle, move) {
+  atomic<unsigned> del_cnt(0);
+  Handle a(new int(1), CountDel{&del_cnt});
+  Handle b(std::move(a));
+  EXPECT_FALSE(a);
+  EXPECT_EQ(b.use_count(), 1);
+
+  /* object previously held by target is released, not kept by source */
+  Handle c(new int(2), CountDel{&del_cnt});
+  c = std::move(b);
+  EXPECT_EQ(del_cnt, 1u);
+  EXPECT_FALSE(b);
+  EXPECT_EQ(*c, 1);
+  EXPECT_EQ(c.use_count(), 1);
+
+  c = std::move(c);
+  EXPECT_EQ(*c, 1);
+  c.reset();
+  EXPECT_EQ(del_cnt, 2u);
+}
+
+TEST(IntrusiveHandle, recycling) {
+  atomic<unsigned> del_cnt(0);
+  Handle a(new int(1), CountDel{&del_cnt});
+  CtrlBlock *blk = a.ctrl_block();
+  a.reset();
+
+  /* released block is reused by next handle of the same thread */
+  Handle b(new int(2), CountDel{&del_cnt});
+  EXPECT_EQ(b.ctrl_block(), blk);
+  EXPECT_EQ(*b, 2);
+}
+
+TEST(IntrusiveHandle, cross_thread_release) {
+  atomic<unsigned> del_cnt(0);
+  const unsigned n = 2 * Block::MAX_FREE + 10;
+
+  vector<Handle> hdls;
+  for (unsigned i = 0; i < n; ++i)
+    hdls.emplace_back(new int(i), CountDel{&del_cnt});
+
+  /* a thread only releasing handles keeps a bounded number of blocks */
+  unsigned free_size = 0;
+  thread thr([&]() {
+    hdls.clear();
+    free_size = Block::free_list().size;
+  });
+  thr.join();
+
+  EXPECT_EQ(del_cnt, n);
+  EXPECT_LE(free_size, Block::MAX_FREE);
+}
@@ -0,0 +1,143 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <bit_exec/obj_man/pool.hxx>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace cingulata;
+using namespace cingulata::obj_man;
+
+namespace {
+/**
+ * @brief      Thread-safe allocator counting created and deleted objects.
+ *             Objects are flags telling whether they are handed out.
+ */
+struct CountingAlloc {
+  void *new_obj() const {
+    nr_new++;
+    return new atomic<bool>(false);
+  }
+
+  void del_obj(void *ptr) const {
+    delete static_cast<atomic<bool> *>(ptr);
+    nr_del++;
+  }
+
+  mutable atomic<size_t> nr_new{0};
+  mutable atomic<size_t> nr_del{0};
+};
+
+using ConcurrentPool = Pool<CountingAlloc, true>;
+
+/**
+ * @brief      Acquire @c nr handles from @c pool, fails if one of them is
+ *             already handed out
+ */
+void acquire(ConcurrentPool &pool, vector<ObjHandle> &hdls, const unsigned nr) {
+  for (unsigned i = 0; i < nr; ++i) {
+    hdls.push_back(pool.new_handle());
+    EXPECT_FALSE(hdls.back().get<atomic<bool>>()->exchange(true));
+  }
+}
+
+void release(vector<ObjHandle> &hdls) {
+  for (ObjHandle &hdl : hdls) {
+    hdl.get<atomic<bool>>()->store(false);
+    hdl = ObjHandle();
+  }
+  hdls.clear();
+}
+} // namespace
+
+TEST(Pool, concurrent_acquire_release) {
+  const unsigned nr_threads = 8;
+  CountingAlloc alloc;
+  {
+    ConcurrentPool pool(alloc);
+
+    vector<thread> threads;
+    for (unsigned t = 0; t < nr_threads; ++t) {
+      threads.emplace_back([&pool, t]() {
+        vector<ObjHandle> hdls;
+        for (unsigned iter = 0; iter < 200; ++iter) {
+          acquire(pool, hdls, 50 + (t * 37 + iter * 11) % 150);
+          release(hdls);
+        }
+      });
+    }
+    for (thread &th : threads)
+      th.join();
+
+    ASSERT_GT(alloc.nr_new, 0);
+    ASSERT_GE(alloc.nr_new, alloc.nr_del);
+  }
+  ASSERT_EQ(alloc.nr_new, alloc.nr_del);
+}
+
+TEST(Pool, cross_thread_release) {
+  const unsigned nr_threads = 4;
+  CountingAlloc alloc;
+  {
+    ConcurrentPool pool(alloc);
+    vector<vector<ObjHandle>> hdls(nr_threads);
+
+    for (unsigned round = 0; round < 20; ++round) {
+      /* each thread acquires handles, then releases those acquired by its
+       * neighbour */
+      vector<thread> threads;
+      for (unsigned t = 0; t < nr_threads; ++t)
+        threads.emplace_back([&, t]() { acquire(pool, hdls[t], 300); });
+      for (thread &th : threads)
+        th.join();
+      ASSERT_GE(alloc.nr_new - alloc.nr_del, nr_threads * 300);
+
+      threads.clear();
+      for (unsigned t = 0; t < nr_threads; ++t)
+        threads.emplace_back(
+            [&, t]() { release(hdls[(t + round + 1) % nr_threads]); });
+      for (thread &th : threads)
+        th.join();
+    }
+  }
+  ASSERT_EQ(alloc.nr_new, alloc.nr_del);
+}
+
+TEST(Pool, bounded_retention) {
+  const size_t max_retained = 256;
+  CountingAlloc alloc;
+  ConcurrentPool pool(alloc, max_retained);
+
+  vector<ObjHandle> hdls;
+  acquire(pool, hdls, 10000);
+  ASSERT_EQ(alloc.nr_new, 10000);
+  release(hdls);
+  ASSERT_LE(pool.retained(), max_retained);
+  ASSERT_GT(alloc.nr_del, 0);
+
+  pool.clear();
+  ASSERT_EQ(pool.retained(), 0);
+  ASSERT_EQ(alloc.nr_new, alloc.nr_del);
+}
@@ -0,0 +1,109 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <bit_exec/clear.hxx>
+#include <bit_exec/decorator/attach.hxx>
+#include <bit_exec/decorator/profile.hxx>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace std;
+using namespace cingulata;
+
+TEST(ProfileDecorator, report) {
+  typedef decorator::Profile<BitExecClear> Profile;
+  decorator::Attach<BitExecClear, Profile> exec;
+
+  const long live = exec.live_obj_cnt();
+  {
+    ObjHandle a = exec.encrypt(1);
+    ObjHandle b = exec.encrypt(0);
+    ObjHandle x = exec.op_or(a, b);
+    EXPECT_EQ(exec.live_obj_cnt(), live + 3);
+
+    /* operations of other threads are merged */
+    thread thr([&]() {
+      for (unsigned i = 0; i < 10; ++i)
+        x = exec.op_xor(x, a);
+    });
+    thr.join();
+
+    EXPECT_EQ(exec.decrypt(x), 1u);
+  }
+  EXPECT_EQ(exec.live_obj_cnt(), live);
+  EXPECT_GE(exec.live_obj_peak(), live + 3);
+
+  /* OR gate is decomposed into timed AND and XOR gates */
+  const Profile::OpProfile and_prof = exec.op_profile(Profile::Op::AND);
+  const Profile::OpProfile xor_prof = exec.op_profile(Profile::Op::XOR);
+  EXPECT_EQ(and_prof.count, 1u);
+  EXPECT_EQ(xor_prof.count, 12u);
+  EXPECT_EQ(exec.op_profile(Profile::Op::ENCRYPT).count, 2u);
+  EXPECT_EQ(exec.op_profile(Profile::Op::OR).count, 0u);
+  EXPECT_EQ(exec.gate_cnt(), 13u);
+
+  uint64_t hist_cnt = 0;
+  for (const uint64_t cnt : xor_prof.hist)
+    hist_cnt += cnt;
+  EXPECT_EQ(hist_cnt, xor_prof.count);
+  EXPECT_LE(xor_prof.min_ns, xor_prof.quantile_ns(0.5));
+  EXPECT_LE(xor_prof.quantile_ns(0.99), xor_prof.max_ns);
+
+  stringstream json;
+  exec.export_json(json);
+  EXPECT_NE(json.str().find("\"gates\": 13,"), string::npos);
+  EXPECT_NE(json.str().find("\"xor\": {\"count\": 12,"), string::npos);
+
+  stringstream csv;
+  exec.export_csv(csv);
+  string line;
+  getline(csv, line);
+  EXPECT_EQ(line.find("op,count,total_ns,min_ns,max_ns,mean_ns,p50_ns,p99_ns,h0,"), 0u);
+  unsigned lines = 0;
+  while (getline(csv, line))
+    lines++;
+  EXPECT_EQ(lines, 4u); // encrypt, decrypt, and, xor
+
+  exec.reset();
+  EXPECT_EQ(exec.gate_cnt(), 0u);
+}
+
+TEST(ProfileDecorator, live_obj_cnt_opt_in) {
+  BitExecClear plain_exec;
+  const long live = obj_man::live_obj_cnt().load();
+
+  /* objects are not counted without profiler */
+  ObjHandle a = plain_exec.encrypt(1);
+  EXPECT_EQ(obj_man::live_obj_cnt().load(), live);
+
+  {
+    decorator::Attach<BitExecClear, decorator::Profile<BitExecClear>> exec;
+    ObjHandle b = plain_exec.encrypt(1);
+    EXPECT_EQ(exec.live_obj_cnt(), live + 1);
+    a.reset();
+    EXPECT_EQ(exec.live_obj_cnt(), live + 1);
+  }
+
+  ObjHandle c = plain_exec.encrypt(1);
+  EXPECT_EQ(obj_man::live_obj_cnt().load(), live);
+}
@@ -0,0 +1,146 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <bit_exec/clear.hxx>
+#include <bit_exec/trace.hxx>
+#include <bit_exec/tracker.hxx>
+#include <ci_context.hxx>
+#include <ci_int.hxx>
+#include <int_op_gen/size.hxx>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace std;
+using namespace cingulata;
+
+namespace {
+/**
+ * @brief      Records the circuit of @c a*b+(a^b) for 8-bit unsigned integers
+ */
+Trace record_circuit() {
+  shared_ptr<IBitExec> bit_exec = CiContext::get_bit_exec();
+  shared_ptr<IIntOpGen> int_op_gen = CiContext::get_int_op_gen();
+  shared_ptr<BitTracker> tracker = make_shared<BitTracker>();
+  CiContext::set_config(tracker, make_shared<IntOpGenSize>());
+
+  CiInt a(0, 8, false);
+  CiInt b(0, 8, false);
+  a.encrypt();
+  b.encrypt();
+
+  CiInt c = a * b + (a ^ b);
+  for (unsigned i = 0; i < c.size(); ++i)
+    c[i].decrypt();
+
+  Trace trace = tracker->export_trace();
+  CiContext::set_config(bit_exec, int_op_gen);
+  return trace;
+}
+
+vector<ObjHandle> encode_inputs(IBitExec &exec, const unsigned a,
+                                const unsigned b) {
+  vector<ObjHandle> inps;
+  for (unsigned i = 0; i < 8; ++i)
+    inps.push_back(exec.encode((a >> i) & 1));
+  for (unsigned i = 0; i < 8; ++i)
+    inps.push_back(exec.encode((b >> i) & 1));
+  return inps;
+}
+
+/**
+ * @brief      Clear-text executor which counts executed gates, usable from
+ *             several threads
+ */
+class CountingExec : public BitExecClear {
+public:
+  ObjHandle op_not(const ObjHandle &in) override {
+    nr_gates++;
+    return BitExecClear::op_not(in);
+  }
+  ObjHandle op_and(const ObjHandle &in1, const ObjHandle &in2) override {
+    nr_gates++;
+    return BitExecClear::op_and(in1, in2);
+  }
+  ObjHandle op_xor(const ObjHandle &in1, const ObjHandle &in2) override {
+    nr_gates++;
+    return BitExecClear::op_xor(in1, in2);
+  }
+
+  atomic<unsigned> nr_gates{0};
+};
+
+unsigned decode_outputs(IBitExec &exec, const vector<ObjHandle> &outs) {
+  unsigned val = 0;
+  for (unsigned i = 0; i < outs.size(); ++i)
+    val |= (exec.decrypt(outs[i]) & 1) << i;
+  return val;
+}
+} // namespace
+
+TEST(Trace, record) {
+  Trace trace = record_circuit();
+
+  ASSERT_EQ(trace.input_names().size(), 16);
+  ASSERT_EQ(trace.output_names().size(), 8);
+  ASSERT_GT(trace.depth(), 0);
+}
+
+TEST(Trace, replay) {
+  Trace trace = record_circuit();
+  BitExecClear exec;
+
+  for (unsigned a = 0; a < 256; a += 7) {
+    for (unsigned b = 0; b < 256; b += 13) {
+      vector<ObjHandle> outs = trace.replay(exec, encode_inputs(exec, a, b));
+      ASSERT_EQ(decode_outputs(exec, outs), (a * b + (a ^ b)) & 0xFF);
+    }
+  }
+}
+
+#if not defined(OBJ_HANDLE_INTRUSIVE) or defined(OBJ_HANDLE_THREAD_SAFE)
+TEST(Trace, replay_parallel) {
+  Trace trace = record_circuit();
+  BitExecClear exec;
+
+  for (unsigned a = 0; a < 256; a += 37) {
+    for (unsigned b = 0; b < 256; b += 41) {
+      vector<ObjHandle> outs =
+          trace.replay(exec, encode_inputs(exec, a, b), 4);
+      ASSERT_EQ(decode_outputs(exec, outs), (a * b + (a ^ b)) & 0xFF);
+    }
+  }
+}
+
+TEST(Trace, replay_parallel_gate_count) {
+  Trace trace = record_circuit();
+  CountingExec seq_exec;
+  trace.replay(seq_exec, encode_inputs(seq_exec, 0, 0));
+
+  for (unsigned nr_threads : {2, 3, 8}) {
+    CountingExec exec;
+    vector<ObjHandle> outs =
+        trace.replay(exec, encode_inputs(exec, 201, 77), nr_threads);
+    ASSERT_EQ(decode_outputs(exec, outs), (201 * 77 + (201 ^ 77)) & 0xFF);
+    ASSERT_EQ(exec.nr_gates, seq_exec.nr_gates);
+  }
+}
+#endif
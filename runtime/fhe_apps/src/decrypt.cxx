@@ -25,9 +25,13 @@
 
 #include "fv.hxx"
 
+#include <algorithm>
 #include <string>
 #include <iostream>
+#include <fstream>
 #include <vector>
+#include <math.h>
+#include <dirent.h>
 
 #include <boost/program_options.hpp>
 
@@ -41,10 +45,58 @@ struct Options {
   bool noise;
   unsigned int nbCoeffs;
   unsigned  int nrThreads;
+  string InputDir;
+  string InputDirSuffix;
+  string InputListFile;
+  unsigned int bitCnt;
+  bool msbFirst;
   vector<string> InputFiles;
   bool verbose;
 };
 
+/**
+ * @brief Append to \c files the (sorted) names of the files in directory
+ *  \c dirName ending with \c suffix
+ */
+void listDirectory(const string& dirName, const string& suffix, vector<string>& files) {
+  DIR* dir = opendir(dirName.c_str());
+  if (dir == NULL) {
+    cerr << "ERROR: Cannot open input directory '" << dirName << "'" << endl;
+    exit(-1);
+  }
+
+  vector<string> names;
+  struct dirent* entry;
+  while ((entry = readdir(dir)) != NULL) {
+    string name(entry->d_name);
+    if (name == "." or name == "..") continue;
+    if (name.size() < suffix.size() or
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+      continue;
+    names.push_back(name);
+  }
+  closedir(dir);
+
+  sort(names.begin(), names.end());
+  for (const string& name: names) {
+    files.push_back(dirName + "/" + name);
+  }
+}
+
+/**
+ * @brief Build an integer from bits, least significant bit first
+ */
+long long fromBinary(const vector<int>& bits, const bool isSigned) {
+  long long num = 0;
+  for (unsigned int i = 0; i < bits.size(); i++) {
+    num |= (long long)(bits[i] & 1) << i;
+  }
+  if (isSigned and not bits.empty() and (bits.back() & 1)) {
+    num -= 1LL << bits.size();
+  }
+  return num;
+}
+
 Options parseArgs(int argc, char** argv) {
   Options options;
 
@@ -56,15 +108,20 @@ Options parseArgs(int argc, char** argv) {
 
       ("nb_coef", po::value<unsigned  int>(&options.nbCoeffs)->default_value(1), "Number of polynomial coefficients to output (first one only by default). Use '0' for all coefficients.")
 
-      ("noise", po::bool_switch(&options.noise)->default_value(false), "Output ciphertext noise (only works with verbose option on)")
+      ("noise", po::bool_switch(&options.noise)->default_value(false), "Output ciphertext noise and remaining noise budget (in bits), computed in the same pass as decryption")
       ("threads", po::value<unsigned  int>(&options.nrThreads)->default_value(1), "Number of parallel execution threads")
+      ("dir", po::value<string>(&options.InputDir), "Decrypt all files from directory (sorted by name)")
+      ("dir-suffix", po::value<string>(&options.InputDirSuffix)->default_value(".ct"), "Suffix of files to decrypt from directory")
+      ("inp-file", po::value<string>(&options.InputListFile), "Read input file names from file")
+      ("bit-cnt", po::value<unsigned int>(&options.bitCnt)->default_value(0), "Pack decrypted bits (first coefficient of consecutive inputs) into integers of given size. Use '0' to disable.")
+      ("msb-first", po::bool_switch(&options.msbFirst)->default_value(false), "Most significant bit first when packing bits")
       ("help,h", "produce help message")
       ("verbose,v", po::bool_switch(&options.verbose)->default_value(false), "enable verbosity")
   ;
 
   po::options_description hidden("Hidden");
   hidden.add_options()
-      ("input-file", po::value< vector<string> >(&options.InputFiles)->required(), "")
+      ("input-file", po::value< vector<string> >(&options.InputFiles), "")
   ;
 
   po::options_description all("All");
@@ -89,11 +146,36 @@ Options parseArgs(int argc, char** argv) {
         " [options] f0.ct f1.ct f2.ct" << endl;
       cout << "Example 2 - decrypt first 3 coefficients from f0.ct, f1.ct and f2.ct:\n\t" << argv[0] <<
         " [options] f0.ct f1.ct f2.ct --nb_coef 3" << endl;
+      cout << "Example 3 - decrypt all output bits in directory 'output' into 8-bit integers:\n\t" << argv[0] <<
+        " [options] --dir output --bit-cnt 8 --threads 4" << endl;
       cout << config << endl;
       exit(0);
     }
     
     po::notify(vm);
+
+    /* Append input files from list file and directory */
+    if (vm.count("inp-file") != 0) {
+      ifstream file(options.InputListFile.c_str());
+      if (not file.is_open()) {
+        cerr << "ERROR: Cannot open input files list '" << options.InputListFile << "'" << endl;
+        exit(-1);
+      }
+      string fileName;
+      while (file >> fileName) {
+        options.InputFiles.push_back(fileName);
+      }
+    }
+
+    if (vm.count("dir") != 0) {
+      listDirectory(options.InputDir, options.InputDirSuffix, options.InputFiles);
+    }
+
+    if (options.InputFiles.empty()) {
+      cerr << "ERROR: No input files to decrypt!" << endl;
+      cerr << config << endl;
+      exit(-1);
+    }
   } catch (po::error& e) {
     cerr << "ERROR: " << e.what() << endl;
     cerr << config << endl;
@@ -140,24 +222,31 @@ int main(int argc, char **argv) {
   KeysAll keys;
   keys.readSecretKey(options.SecretKeyFile.c_str());
 
-  #pragma omp parallel for ordered num_threads(options.nrThreads)
+  /* Noise budget is the distance (in bits) to the decryption bound Delta/2 */
+  const double maxNoise = fmpz_dlog(FheParams::Delta) / log(2) - 1;
+
+  vector<int> groupBits;
+  double groupNoise = 0.0;
+
+  #pragma omp parallel for ordered schedule(dynamic) num_threads(options.nrThreads)
   for (unsigned int i = 0; i < options.InputFiles.size(); i++) {
     string fileName = options.InputFiles[i];
 
     CipherText ct;
     ct.read(fileName.c_str());
 
-    PolyRing pTxtPoly = EncDec::DecryptPoly(ct, *keys.SecretKey);
-    unsigned int noise;
+    PolyRing pNoise;
+    PolyRing pTxtPoly = EncDec::DecryptPolyAndNoise(ct, *keys.SecretKey, pNoise);
+    double noise = 0.0;
     if (options.noise) {
-      noise = EncDec::Noise(ct, *keys.SecretKey);
+      noise = EncDec::NoiseDbl(pNoise);
     }
 
     vector<int> msgs;
     for (unsigned int c = 0; c < options.nbCoeffs; ++c) {
       if (c < pTxtPoly.length()) {
         int msg = pTxtPoly.getCoeffUi(c);
-        if (options.signedMessage and (unsigned int)msg > FheParams::T/2) msg -= FheParams::T;
+        if (options.bitCnt == 0 and options.signedMessage and (unsigned int)msg > FheParams::T/2) msg -= FheParams::T;
         msgs.push_back(msg);
       } else {
         msgs.push_back(0);
@@ -165,11 +254,12 @@ int main(int argc, char **argv) {
     }
 
     #pragma omp ordered
-    {
+    if (options.bitCnt == 0) {
       if (options.verbose) {
         cout << "Decrypting file " << fileName;
         if (options.noise) {
-          cout << " - noise " << noise << "/" << FheParams::Q_bitsize;
+          cout << " - noise " << (unsigned int)ceil(noise) << "/" << FheParams::Q_bitsize;
+          cout << " - budget " << (int)floor(maxNoise - noise);
         }
         cout << " - message [";
       }
@@ -181,8 +271,32 @@ int main(int argc, char **argv) {
       }
       if (options.verbose) {
         cout << "]";  
+      } else if (options.noise) {
+        cout << "\t" << (int)floor(maxNoise - noise);
       }
       cout << endl;
+    } else {
+      /* pack first coefficient of consecutive inputs into an integer */
+      groupBits.push_back(msgs[0]);
+      groupNoise = max(groupNoise, noise);
+
+      if (groupBits.size() == options.bitCnt or i == options.InputFiles.size() - 1) {
+        if (options.msbFirst) {
+          reverse(groupBits.begin(), groupBits.end());
+        }
+
+        if (options.verbose) {
+          cout << "Decrypting files up to " << fileName << " - value ";
+        }
+        cout << fromBinary(groupBits, options.signedMessage);
+        if (options.noise) {
+          cout << (options.verbose ? " - budget " : "\t") << (int)floor(maxNoise - groupNoise);
+        }
+        cout << endl;
+
+        groupBits.clear();
+        groupNoise = 0.0;
+      }
     }
   }
 
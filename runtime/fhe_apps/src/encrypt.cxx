@@ -40,6 +40,7 @@ namespace ba = boost::algorithm;
 struct Options {
   string FheParamsFile;
   string PublicKeyFile;
+  string SecretKeyFile;
   string MessageFile;
   bool clear;
   unsigned int nbCoeffs;
@@ -117,6 +118,7 @@ Options parseArgs(int argc, char** argv) {
   config.add_options()
       ("fhe-params", po::value<string>(&options.FheParamsFile)->default_value("fhe_params.xml"), "FHE parameters file")
       ("public-key", po::value<string>(&options.PublicKeyFile)->default_value("fhe_key.pk"), "Public key file")
+      ("secret-key", po::value<string>(&options.SecretKeyFile), "Encrypt with secret key file instead, ciphertexts are written seeded (half size)")
       ("inp-file", po::value<string>(&options.MessageFile), "Read '<output file> [<message>]+' pairs from file")
       ("clear", po::bool_switch(&options.clear)->default_value(false), "'Encrypt' clear messages")
       ("threads", po::value<unsigned int>(&options.nrThreads)->default_value(1), "Number of parallel execution threads")
@@ -250,15 +252,25 @@ int main(int argc, char **argv) {
   if (options.verbose) {
     cout << "Command line arguments:" << endl;
     cout << "FHE parameters file " << options.FheParamsFile << endl;
-    cout << "Public key file " << options.PublicKeyFile << endl;
+    if (options.SecretKeyFile.empty()) {
+      cout << "Public key file " << options.PublicKeyFile << endl;
+    } else {
+      cout << "Secret key file " << options.SecretKeyFile << endl;
+    }
     if (options.nbCoeffs > 1) {
       cout << "Encrypt packed ciphertext: ";
       cout << "use coefficient packing" << endl;
     }
   }
 
-  KeysShare keys;
-  keys.readPublicKey(options.PublicKeyFile);
+  KeysAll keys;
+  if (not options.clear) {
+    if (options.SecretKeyFile.empty()) {
+      keys.readPublicKey(options.PublicKeyFile);
+    } else {
+      keys.readSecretKey(options.SecretKeyFile);
+    }
+  }
 
   #pragma omp parallel for num_threads(options.nrThreads)
   for (unsigned int i = 0; i < options.OutputFilesMessages.size(); ++i) {
@@ -280,6 +292,8 @@ int main(int argc, char **argv) {
 
     if (options.clear) {
       EncDec::EncryptPoly(pTxtPoly).write(out_fn);
+    } else if (keys.SecretKey != NULL) {
+      EncDec::EncryptPolySym(pTxtPoly, *keys.SecretKey).write(out_fn);
     } else {
       EncDec::EncryptPoly(pTxtPoly, *keys.PublicKey).write(out_fn);
     }
@@ -36,6 +36,9 @@ struct Options {
   string FheParamsFile;
   string KeyFilePrefix;
   bool strOutput;
+  bool seeded;
+  bool mapped;
+  unsigned int nrThreads;
 };
 
 Options parseArgs(int argc, char** argv) {
@@ -47,6 +50,9 @@ Options parseArgs(int argc, char** argv) {
       ("fhe-params", po::value<string>(&options.FheParamsFile)->default_value("fhe_params.xml"), "FHE parameters file")
       ("key-file-prefix", po::value<string>(&options.KeyFilePrefix)->default_value("fhe_key"), "Prefix for key files")
       ("strout", po::bool_switch(&options.strOutput)->default_value(false), "Write keys in string format also")
+      ("seeded", po::bool_switch(&options.seeded)->default_value(false), "Write uniform key polynomials as seeds (halves public and evaluation key sizes)")
+      ("mmap", po::bool_switch(&options.mapped)->default_value(false), "Write public and evaluation keys in memory-mappable layout (fast loading)")
+      ("threads", po::value<unsigned int>(&options.nrThreads)->default_value(1), "Number of key generation threads")
       ("help,h", "produce help message")
   ;
 
@@ -84,11 +90,9 @@ int main(int argc, char** argv) {
 
   FheParams::readXml(options.FheParamsFile.c_str());
 
-  KeyGen keygen;
+  KeyGen keygen(options.seeded, options.nrThreads);
 
-  keygen.generateKeys();
-
-  keygen.writeKeys(options.KeyFilePrefix);
+  keygen.generateKeys(options.KeyFilePrefix, true, options.mapped);
   if (options.strOutput) {
     keygen.writeKeys(options.KeyFilePrefix + "_str", false);
   }
@@ -40,6 +40,7 @@ struct Options {
   string FheParamsFile;
   vector<string> FileNames;
   bool stringOutput;
+  unsigned int nrThreads;
 };
 
 Options parseArgs(int argc, char** argv) {
@@ -48,8 +49,9 @@ Options parseArgs(int argc, char** argv) {
   po::options_description config("Options");
   config.add_options()
       ("fhe-params", po::value<string>(&options.FheParamsFile)->default_value("fhe_params.xml"), "FHE parameters file")
-      ("eval-key", po::value<string>(&options.EvalKeyFile)->default_value("fhe_key.evk"), "Eval key file")
+      ("eval-key", po::value<string>(&options.EvalKeyFile)->default_value("fhe_key.evk"), "Eval key file (not used anymore, kept for compatibility)")
       ("strout", po::bool_switch(&options.stringOutput)->default_value(false), "enable ciphertext string output")
+      ("threads", po::value<unsigned int>(&options.nrThreads)->default_value(1), "Number of parallel execution threads")
       ("help,h", "produce help message")
   ;
 
@@ -111,24 +113,32 @@ int main(int argc, char **argv) {
 
   FheParams::readXml(options.FheParamsFile.c_str());
 
-  KeysShare keys;
-  keys.readEvalKey(options.EvalKeyFile);
+  unsigned int nrInputs = options.FileNames.size() - 1;
+  if (nrInputs > FheParams::D) {
+    cerr << "ERROR: Cannot pack " << nrInputs << " ciphertexts, only "
+      << FheParams::D << " polynomial coefficients are available" << endl;
+    exit(-1);
+  }
 
   CipherText ct_res;
   ct_res.read(options.FileNames[0]);
 
-  for (unsigned int i = 1; i < options.FileNames.size() - 1; i++) {
-    string fileName = options.FileNames[i];
+  /* Message i is moved to coefficient i by multiplying with X^i */
+  #pragma omp parallel num_threads(options.nrThreads)
+  {
+    CipherText ct_acc;
 
-    CipherText ct;
-    ct.read(fileName);
+    #pragma omp for schedule(dynamic)
+    for (unsigned int i = 1; i < nrInputs; i++) {
+      CipherText ct;
+      ct.read(options.FileNames[i]);
 
-    PolyRing poly_x;
-    poly_x.setCoeffUi(i, 1);
+      CipherText::multiply_monomial(ct, i);
+      CipherText::add(ct_acc, ct);
+    }
 
-    CipherText poly_x_ct = EncDec::EncryptPoly(poly_x);
-    CipherText::multiply(ct, poly_x_ct, *keys.EvalKey);
-    CipherText::add(ct_res, ct);
+    #pragma omp critical
+    CipherText::add(ct_res, ct_acc);
   }
 
   ct_res.write(options.FileNames.back(), not options.stringOutput);
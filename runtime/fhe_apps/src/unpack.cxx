@@ -0,0 +1,143 @@
+/*
+    (C) Copyright 2017 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+/**
+ * @file unpack.cxx
+ * @brief Utility for extracting coefficients of a packed ciphertext into
+ *  separate ciphertexts (counterpart of pack)
+ */
+
+
+#include "fv.hxx"
+
+#include <string>
+#include <iostream>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+using namespace std;
+namespace po = boost::program_options;
+
+struct Options {
+  string FheParamsFile;
+  vector<string> FileNames;
+  bool stringOutput;
+  unsigned int nrThreads;
+};
+
+Options parseArgs(int argc, char** argv) {
+  Options options;
+
+  po::options_description config("Options");
+  config.add_options()
+      ("fhe-params", po::value<string>(&options.FheParamsFile)->default_value("fhe_params.xml"), "FHE parameters file")
+      ("strout", po::bool_switch(&options.stringOutput)->default_value(false), "enable ciphertext string output")
+      ("threads", po::value<unsigned int>(&options.nrThreads)->default_value(1), "Number of parallel execution threads")
+      ("help,h", "produce help message")
+  ;
+
+  po::options_description hidden("Hidden");
+  hidden.add_options()
+      ("files", po::value< vector<string> >(&options.FileNames), "")
+  ;
+
+  po::options_description all("All");
+  all.add(config).add(hidden);
+
+  po::positional_options_description p;
+  p.add("files", -1);
+
+  try {
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv)
+                  .options(all)
+                  .positional(p)
+                  .run(),
+              vm);
+
+    if (vm.count("help")) {
+      cout << "Unpack a ciphertext packed with polynomial coefficient packing method" << endl;
+      cout << "\tThe i-th output ciphertext encrypts the i-th input coefficient in its first" << endl;
+      cout << "\tcoefficient, other coefficients hold (rotated) remaining messages." << endl;
+      cout << "Usage: " << argv[0] <<
+        " [options] <input file> [<output file>]+" << endl;
+      cout << "Example - unpack first, second and third polynomial coefficients of o.ct into a.ct, b.ct and c.ct:\n\t" << argv[0] <<
+        " [options] o.ct a.ct b.ct c.ct" << endl;
+      cout << config << endl;
+      exit(0);
+    }
+
+    po::notify(vm);
+    
+    if (options.FileNames.size() == 0) {
+      cerr << "Please specify the input file!" << endl;
+      cerr << config << endl;
+      exit(-1);
+    } else if (options.FileNames.size() == 1) {
+      cerr << "Please specify at least one output file!" << endl;
+      cerr << config << endl;
+      exit(-1);
+    }
+  } catch (po::error& e) {
+    cerr << "ERROR: " << e.what() << endl;
+    cerr << config << endl;
+    exit(-1);
+  } catch (...) {
+    cerr << "Something went wrong!!!" << endl;
+    cerr << config << endl;
+    exit(-1);
+  }
+
+  return options;
+}
+
+int main(int argc, char **argv) {
+  Options options = parseArgs(argc, argv);
+
+  FheParams::readXml(options.FheParamsFile.c_str());
+
+  if (not FheParams::IsPowerOfTwoCyclotomic) {
+    cerr << "ERROR: Unpacking is only supported for power of two cyclotomic polynomial rings" << endl;
+    exit(-1);
+  }
+
+  unsigned int nrOutputs = options.FileNames.size() - 1;
+  if (nrOutputs > FheParams::D) {
+    cerr << "ERROR: Cannot unpack " << nrOutputs << " ciphertexts, only "
+      << FheParams::D << " polynomial coefficients are available" << endl;
+    exit(-1);
+  }
+
+  CipherText ct_packed;
+  ct_packed.read(options.FileNames[0]);
+
+  /* Coefficient i is moved to coefficient 0 by multiplying with X^-i = X^(2D-i) */
+  #pragma omp parallel for schedule(dynamic) num_threads(options.nrThreads)
+  for (unsigned int i = 0; i < nrOutputs; i++) {
+    CipherText ct(ct_packed);
+    if (i > 0) {
+      CipherText::multiply_monomial(ct, 2 * FheParams::D - i);
+    }
+    ct.write(options.FileNames[i + 1], not options.stringOutput);
+  }
+
+  return 0;
+}
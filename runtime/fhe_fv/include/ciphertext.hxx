@@ -27,6 +27,7 @@
 
 #include "keys_share.hxx"
 #include "polyring.hxx"
+#include "uniform.hxx"
 
 #include <assert.h>
 #include <string>
@@ -38,6 +39,11 @@ private:
     bool polysAllocated;
     std::vector<PolyRing*> dataPoly;
 
+    /* Seed from which the last polynomial was sampled (if any) */
+    bool seeded;
+    SeededUniformRng::Seed seed;
+    const fmpz* seedModulus;
+
 protected:
 
   /** @brief In-place multiply a ciphertext with a polynomial.
@@ -89,6 +95,17 @@ public:
    */
   static void multiply_comp(CipherText &left_ctr, const CipherText &right_ctr);
 
+  /** @brief In-place multiply a ciphertext with a monomial.
+   *
+   *  Multiply each polynomial of ciphertext \c ctr with \c{X^k}. The
+   *    encrypted message is multiplied by \c{X^k} and noise does not grow,
+   *    so no evaluation key or rounding is needed.
+   *
+   *  @param ctr ciphertext to multiply to.
+   *  @param k monomial degree
+   */
+  static void multiply_monomial(CipherText &ctr, const unsigned int k);
+
   /** @brief Access ciphertext polynomials
    */    
   PolyRing& operator[](const unsigned int idx) const {
@@ -105,6 +122,35 @@ public:
   /** @brief Resize the number of polynomials in the ciphertext
    */    
   void resize(const int newSize);
+
+  /** @brief Mark the last ciphertext polynomial as sampled from a seed
+   *
+   *  The last polynomial must have been obtained with
+   *    \c RandPolynom::sampleUniform from \c p_seed on interval
+   *    \c{[0;p_modulus)}. Seeded ciphertexts are written with the seed
+   *    in place of this polynomial, which is expanded back when read.
+   *  Only \c FheParams::Q and \c FheParams::PQ are valid moduli.
+   *
+   *  \remarks The seed is dropped by any ciphertext operation. Callers
+   *    changing the last polynomial through \c operator[] should call
+   *    \c clearSeed.
+   *
+   *  @param p_seed seed of the last polynomial
+   *  @param p_modulus uniform distribution interval
+   */
+  void setSeed(const SeededUniformRng::Seed& p_seed, const fmpz* p_modulus);
+
+  /** @brief Forget the seed of the last polynomial
+   */
+  void clearSeed() {
+    seeded = false;
+  }
+
+  /** @brief Return true if the last polynomial is represented by a seed
+   */
+  bool isSeeded() const {
+    return seeded;
+  }
     
   /** @brief Constructs an empty CipherText.
    */
@@ -197,6 +243,33 @@ public:
    *  @param outFileName file name to which to write
    */
   void write(const std::string& outFileName, const bool binary = true) const;
+
+  /** @brief Check if a file uses the memory-mappable layout
+   *
+   *  @param fileName name of the file to check
+   */
+  static bool isMappedFile(const std::string& fileName);
+
+  /** @brief Read ciphertext from a memory-mappable file
+   *
+   *  The file is mapped read-only and shared, thus processes reading the
+   *    same file use the same page cache entries. Coefficients are unpacked
+   *    straight from the mapped limbs, no stream parsing is done.
+   *
+   *  @param inFileName name of the file from which to read
+   */
+  void readMapped(const std::string& inFileName);
+
+  /** @brief Write ciphertext to a memory-mappable file
+   *
+   *  File layout: a header page followed by polynomials, each one starting
+   *    on a page boundary and holding fixed-size little-endian limb
+   *    coefficients. Polynomial coefficients must be non-negative.
+   *    Seeds are not kept, uniform polynomials are written in full.
+   *
+   *  @param outFileName file name to which to write
+   */
+  void writeMapped(const std::string& outFileName) const;
 };
 
 #endif
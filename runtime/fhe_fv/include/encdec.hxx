@@ -61,6 +61,20 @@ public:
    */
   static CipherText EncryptPoly(const PolyRing& pTxt, const CipherText& publicKey);
 
+  /**
+   * @brief Encrypts a polynomial ring element with the secret key
+   * @details The ciphertext is \c (-(a.s+e)+Delta.m, a) with \c a uniform.
+   *    When \c seeded is true, \c a is sampled from a fresh seed which is
+   *    written instead of \c a, halving the ciphertext file size.
+   *
+   * @param pTxt polynomial ring element to encrypt
+   * @param secretKey secret key
+   * @param seeded sample uniform polynomial from a seed
+   *
+   * @return a ciphertext object with encrypted polynomial
+   */
+  static CipherText EncryptPolySym(const PolyRing& pTxt, const PolyRing& secretKey, const bool seeded = true);
+
   /**
    * @brief Builds a "plain" ciphertext object
    * @details Builds a "plain" ciphertext object used in combined computations
@@ -32,15 +32,42 @@
 class KeyGen {
   private:
     KeysAll keysAll;
+    bool seededKeys;
+    unsigned int nrThreads;
 
   protected:
     void generateSecretKey();
-    void generatePublicKey();
-    void generateEvalKey();
+    void generatePublicKey(const unsigned int p_nrThreads = 1);
+    void generateEvalKey(const unsigned int p_nrThreads = 1);
 
   public:
+    /** @brief Constructs a key generator
+     *
+     *  @param p_seededKeys if true the uniform polynomial of public and
+     *    evaluation keys is represented by a seed in key files
+     *  @param p_nrThreads number of threads used for key generation
+     */
+    KeyGen(const bool p_seededKeys = false, const unsigned int p_nrThreads = 1):
+      seededKeys(p_seededKeys), nrThreads(p_nrThreads > 0 ? p_nrThreads : 1) {}
+
     void generateKeys();
+
+    /** @brief Generate keys and write each one as soon as it is available
+     *
+     *  Public and evaluation keys are generated concurrently (when more
+     *    than one thread is used) and files are written while remaining
+     *    keys are being computed.
+     *
+     *  @param fileNamePrefix prefix of files names containing keys
+     *  @param binary either to write keys as binary or as string
+     *  @param mapped write public and evaluation keys in memory-mappable
+     *    layout (\c binary is ignored for them)
+     */
+    void generateKeys(const std::string& fileNamePrefix, const bool binary = true,
+                      const bool mapped = false);
+
     void writeKeys(const std::string& fileNamePrefix, const bool binary = true);
+    void writeKeysMapped(const std::string& fileNamePrefix);
 };
 
 #endif
@@ -74,6 +74,13 @@ class KeysAll : public KeysShare {
      *  @param binary either to write keys as binary or as string
      */
     void writeKeys(const std::string& fileNamePrefix, const bool binary = true);
+
+    /** @brief Write all keys to files with a given prefix, public and
+     *    evaluation keys use the memory-mappable layout
+     *
+     *  @param fileNamePrefix prefix of files names containing keys
+     */
+    void writeKeysMapped(const std::string& fileNamePrefix);
 };
 
 #endif
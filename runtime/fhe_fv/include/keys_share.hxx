@@ -50,24 +50,32 @@ class KeysShare {
     ~KeysShare();
 
     /** @brief Read public key from an input stream
+     *
+     *  Keys written with a seeded uniform polynomial are expanded here.
      *
      *  @param in_io input stream from which read the key
      */
     void readPublicKey(FILE* const stream, const bool binary = true);
 
     /** @brief Read public key from a file
+     *
+     *  Files in memory-mappable layout are detected and mapped.
      *
      *  @param fileName input file name from which read the key
      */
     void readPublicKey(const std::string& fileName, const bool binary = true);
 
     /** @brief Read evaluation key from an input stream
+     *
+     *  Keys written with a seeded uniform polynomial are expanded here.
      *
      *  @param in_io input stream from which read the key
      */
     void readEvalKey(FILE* const stream, const bool binary = true);
 
     /** @brief Read evaluation key from a file
+     *
+     *  Files in memory-mappable layout are detected and mapped.
      *
      *  @param fileName input file name from which read the key
      */
@@ -96,6 +104,13 @@ class KeysShare {
      *  @param fileNamePrefix prefix of files names containing keys
      */
     void writeKeys(const std::string& fileNamePrefix, const bool binary = true);
+
+    /** @brief Write all keys to files with a given prefix using the
+     *    memory-mappable layout (see \c CipherText::writeMapped)
+     *
+     *  @param fileNamePrefix prefix of files names containing keys
+     */
+    void writeKeysMapped(const std::string& fileNamePrefix);
 };
 
 #endif
@@ -201,6 +201,18 @@ public:
    */
   static void square(PolyRing &poly);
 
+  /** @brief In-place multiply a polynomial with a monomial.
+   *
+   *  This function performs the following operation:
+   *    \c{poly = poly * X^k}
+   *  For power of two cyclotomic rings this is a negacyclic rotation
+   *    of coefficients (\c{X^D = -1}), no polynomial product is done.
+   *
+   *  @param poly polynomial to multiply
+   *  @param k monomial degree
+   */
+  static void multiply_monomial(PolyRing &poly, const unsigned int k);
+
   /** @brief Assignment operator
    *
    *  Assigns a copy of polynomial object \c poly to current object.
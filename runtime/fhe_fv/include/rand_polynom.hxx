@@ -25,6 +25,8 @@
 #ifndef __RAND_POLYNOM_HXX__
 #define __RAND_POLYNOM_HXX__
 
+#include "uniform.hxx"
+
 #include <flint/fmpz_poly.h>
 
 class RandPolynom {
@@ -75,9 +77,11 @@ class RandPolynom {
      *  @param poly the polynomial to sample
      *  @param len the length of the polynomial to sample
      *  @param coefBitCnt number of bits in polynomial coefficients
+     *  @param nrThreads number of threads sampling coefficients
      */
     static void sampleUniform(fmpz_poly_t poly, unsigned int len,
-                              unsigned int coefBitCnt);
+                              unsigned int coefBitCnt,
+                              unsigned int nrThreads = 1);
 
     /** @brief Sample a polynomial according to an uniform distribution
      *
@@ -88,8 +92,27 @@ class RandPolynom {
      *  @param poly the polynomial to sample
      *  @param len the length of the polynomial to sample
      *  @param q uniform distribution interval
+     *  @param nrThreads number of threads sampling coefficients
      */
-    static void sampleUniform(fmpz_poly_t poly, unsigned int len, fmpz_t q);
+    static void sampleUniform(fmpz_poly_t poly, unsigned int len, fmpz_t q,
+                              unsigned int nrThreads = 1);
+
+    /** @brief Sample a polynomial according to an uniform distribution
+     *    deterministically from a seed
+     *
+     *  This method samples a polynomial of length \c len with coefficients
+     *    uniformly distributed on \c{[0;q)}. Coefficients are taken from
+     *    the stream of a \c SeededUniformRng initialized with \c seed,
+     *    thus the same seed always gives the same polynomial.
+     *
+     *  @param poly the polynomial to sample
+     *  @param len the length of the polynomial to sample
+     *  @param q uniform distribution interval
+     *  @param seed seed of the pseudo-random generator
+     */
+    static void sampleUniform(fmpz_poly_t poly, unsigned int len,
+                              const fmpz_t q,
+                              const SeededUniformRng::Seed& seed);
     
     /** @brief Sample a polynomial according to a normal distribution
      *
@@ -27,6 +27,9 @@
 
 #include <flint/fmpz.h>
 
+#include <array>
+#include <stdint.h>
+
 class UniformRng {
   protected:
     /** @brief Initializes uniform RNG.
@@ -52,6 +55,18 @@ class UniformRng {
      */
     static void sample(fmpz_t num, unsigned int bitCnt);
 
+    /** @brief Sample several numbers from uniform distribution.
+     *
+     *  Same as \c sample(num, bitCnt) applied to \c cnt numbers, but
+     *    the random device is opened once and read in large blocks.
+     *  Numbers in \c nums should be initialized.
+     *
+     *  @param nums array of sampled numbers
+     *  @param cnt number of numbers to sample
+     *  @param bitCnt number of bits in each number
+     */
+    static void sampleVec(fmpz* nums, unsigned int cnt, unsigned int bitCnt);
+
     /** @brief Sample number from uniform distribution with a given
      *     Hamming weight.
      *
@@ -74,4 +89,58 @@ class UniformRng {
                         unsigned int hammingWeight);
 };
 
+/** @brief Deterministic uniform random number generator.
+ *
+ *  Expands a short seed into an uniformly distributed stream using the
+ *    ChaCha20 stream cipher (seed is the key, nonce is zero). Two generators
+ *    built from the same seed yield the same sequence of numbers, which allows
+ *    to replace uniformly sampled data (e.g. the \c a polynomial of keys and
+ *    of fresh symmetric ciphertexts) by its seed.
+ */
+class SeededUniformRng {
+  public:
+    /** @brief Seed size in bytes
+     */
+    static const unsigned int SEED_SIZE = 32;
+
+    typedef std::array<unsigned char, SEED_SIZE> Seed;
+
+    /** @brief Sample a fresh seed from \c /dev/urandom
+     *
+     *  @param seed sampled seed
+     */
+    static void generateSeed(Seed& seed);
+
+    /** @brief Constructs a generator from a seed
+     *
+     *  @param seed generator seed
+     */
+    SeededUniformRng(const Seed& seed);
+
+    /** @brief Sample number from uniform distribution.
+     *
+     *  This method samples a number \c num uniformly
+     *    defined on interval [0;2^bitCnt).
+     *  Variable \c num should be initialized.
+     *
+     *  @param num sampled number
+     *  @param bitCnt number of bits in \c num
+     */
+    void sample(fmpz_t num, unsigned int bitCnt);
+
+  protected:
+    /** @brief Fill \c buff with the next \c len bytes of the stream
+     */
+    void nextBytes(unsigned char* buff, unsigned int len);
+
+    /** @brief Compute next key-stream block
+     */
+    void nextBlock();
+
+  private:
+    uint32_t state[16];
+    unsigned char block[64];
+    unsigned int blockPos;
+};
+
 #endif
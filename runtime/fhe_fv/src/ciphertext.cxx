@@ -20,8 +20,16 @@
 
 #include "fhe_params.hxx"
 #include "ciphertext.hxx"
+#include "rand_polynom.hxx"
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -47,6 +55,7 @@ void CipherText::relinearize(CipherText& ctr, const CipherText& EvalKey) {
 /** @brief See header for a description
  */
 void CipherText::modulo(CipherText& ctr, const fmpz_t q) {
+  ctr.clearSeed();
   for (unsigned int i = 0; i < ctr.size(); i++) {
     PolyRing::modulo(ctr[i], q);
   }
@@ -55,6 +64,7 @@ void CipherText::modulo(CipherText& ctr, const fmpz_t q) {
 /** @brief See header for a description
  */
 void CipherText::multiply_round(CipherText& ctr, const unsigned int t, const fmpz_t q) {
+  ctr.clearSeed();
   for (unsigned int i = 0; i < ctr.size(); i++) {
     PolyRing::multiply_round(ctr[i], t, q);
   }
@@ -64,16 +74,29 @@ void CipherText::multiply_round(CipherText& ctr, const unsigned int t, const fmp
  */
 void CipherText::multiply_comp(CipherText& left_ctr, const CipherText& right_ctr) {
   assert(left_ctr.size() == right_ctr.size());
-  
+  left_ctr.clearSeed();
+
   for (unsigned int i = 0; i < left_ctr.size(); i++) {
     PolyRing::multiply(left_ctr[i], right_ctr[i]);
   }
 }
 
+/** @brief See header for a description
+ */
+void CipherText::multiply_monomial(CipherText& ctr, const unsigned int k) {
+  ctr.clearSeed();
+
+  for (unsigned int i = 0; i < ctr.size(); i++) {
+    PolyRing::multiply_monomial(ctr[i], k);
+  }
+
+  CipherText::modulo(ctr, FheParams::Q);
+}
+
 /** @brief See header for a description
  */
 CipherText::CipherText(unsigned int p_nrPolys):
-    polysAllocated(true) {
+    polysAllocated(true), seeded(false), seedModulus(NULL) {
 
   dataPoly.resize(p_nrPolys, NULL);
   for (unsigned int i = 0; i < dataPoly.size(); ++i) {
@@ -84,7 +107,8 @@ CipherText::CipherText(unsigned int p_nrPolys):
 /** @brief See header for a description
  */
 CipherText::CipherText(const CipherText& ct):
-    polysAllocated(true) {
+    polysAllocated(true), seeded(ct.seeded), seed(ct.seed),
+    seedModulus(ct.seedModulus) {
 
   dataPoly.resize(ct.size(), NULL);
   for (unsigned int i = 0; i < dataPoly.size(); ++i) {
@@ -95,7 +119,7 @@ CipherText::CipherText(const CipherText& ct):
 /** @brief See header for a description
  */
 CipherText::CipherText(const PolyRing& cp0):
-    polysAllocated(true) {
+    polysAllocated(true), seeded(false), seedModulus(NULL) {
 
   dataPoly.resize(1, NULL);
   dataPoly[0] = new PolyRing(cp0);
@@ -104,7 +128,7 @@ CipherText::CipherText(const PolyRing& cp0):
 /** @brief See header for a description
  */
 CipherText::CipherText(const PolyRing& cp0, const PolyRing& cp1):
-    polysAllocated(true) {
+    polysAllocated(true), seeded(false), seedModulus(NULL) {
 
   dataPoly.resize(2, NULL);
   dataPoly[0] = new PolyRing(cp0);
@@ -114,7 +138,7 @@ CipherText::CipherText(const PolyRing& cp0, const PolyRing& cp1):
 /** @brief See header for a description
  */
 CipherText::CipherText(PolyRing* const cp0, PolyRing* const cp1):
-    polysAllocated(false) {
+    polysAllocated(false), seeded(false), seedModulus(NULL) {
 
   dataPoly.resize(2, NULL);
   dataPoly[0] = cp0;
@@ -134,6 +158,8 @@ CipherText::~CipherText() {
 /** @brief See header for a description
  */
 void CipherText::add(CipherText& ct1, const CipherText& ct2) {
+  ct1.clearSeed();
+
   if (ct1.size() < ct2.size()) {
     ct1.resize(ct2.size());
   }
@@ -148,6 +174,8 @@ void CipherText::add(CipherText& ct1, const CipherText& ct2) {
 /** @brief See header for a description
  */
 void CipherText::sub(CipherText& ct1, const CipherText& ct2) {
+  ct1.clearSeed();
+
   if (ct1.size() < ct2.size()) {
     ct1.resize(ct2.size());
   }
@@ -212,31 +240,106 @@ void CipherText::multiply(CipherText& ct1, const CipherText& ct2) {
 /** @brief See header for a description
  */
 void CipherText::multiply_by_poly(CipherText& ct1, const PolyRing& p2) {
+  ct1.clearSeed();
+
   for (unsigned int i = 0; i < ct1.size(); ++i) {
     PolyRing::multiply(ct1[i], p2);
   }
 }
 
+/** @brief Convert a seed to an integer (little-endian byte order)
+ */
+static void seed_to_fmpz(fmpz_t d, const SeededUniformRng::Seed& seed) {
+  fmpz_zero(d);
+  for (int i = seed.size() - 1; i >= 0; --i) {
+    fmpz_mul_2exp(d, d, 8);
+    fmpz_add_ui(d, d, seed[i]);
+  }
+}
+
+/** @brief Convert an integer to a seed (little-endian byte order)
+ */
+static void fmpz_to_seed(SeededUniformRng::Seed& seed, const fmpz_t d) {
+  fmpz_t tmp;
+  fmpz_init_set(tmp, d);
+  for (unsigned int i = 0; i < seed.size(); ++i) {
+    seed[i] = fmpz_fdiv_ui(tmp, 256);
+    fmpz_fdiv_q_2exp(tmp, tmp, 8);
+  }
+  fmpz_clear(tmp);
+}
+
+/** @brief See header for a description
+ */
+void CipherText::setSeed(const SeededUniformRng::Seed& p_seed, const fmpz* p_modulus) {
+  assert(size() > 0);
+  assert(fmpz_equal(p_modulus, FheParams::Q) or fmpz_equal(p_modulus, FheParams::PQ));
+
+  seeded = true;
+  seed = p_seed;
+  seedModulus = p_modulus;
+}
+
 /** @brief See header for a description
  */
 void CipherText::read(FILE* const stream, const bool binary) {
   fmpz_t size_fmpz;
   fmpz_init(size_fmpz);
 
+  /* negative size means the last polynomial is stored as a seed */
   PolyRing::read_fmpz(size_fmpz, stream, binary);
+  bool seededFormat = fmpz_sgn(size_fmpz) < 0;
+  fmpz_abs(size_fmpz, size_fmpz);
   unsigned int size = fmpz_get_ui(size_fmpz);
 
   this->resize(size);
-  for (unsigned int i = 0; i < this->size(); i++) {
+  unsigned int nrPolys = seededFormat ? size - 1 : size;
+  for (unsigned int i = 0; i < nrPolys; i++) {
     dataPoly[i]->read(stream, binary);
   }
 
+  if (seededFormat) {
+    fmpz_t tmp;
+    fmpz_init(tmp);
+
+    const fmpz* modulus = NULL;
+    PolyRing::read_fmpz(tmp, stream, binary);
+    if (fmpz_equal(tmp, FheParams::Q)) {
+      modulus = FheParams::Q;
+    } else if (fmpz_equal(tmp, FheParams::PQ)) {
+      modulus = FheParams::PQ;
+    } else {
+      cerr << "ERROR: Ciphertext::read seeded polynomial modulus does not "
+        "match FHE parameters" << endl;
+      exit(-1);
+    }
+
+    SeededUniformRng::Seed seed;
+    PolyRing::read_fmpz(tmp, stream, binary);
+    fmpz_to_seed(seed, tmp);
+
+    fmpz_poly_t poly;
+    fmpz_poly_init(poly);
+    RandPolynom::sampleUniform(poly, FheParams::D, modulus, seed);
+    *dataPoly[size - 1] = PolyRing(poly);
+    fmpz_poly_clear(poly);
+
+    setSeed(seed, modulus);
+
+    fmpz_clear(tmp);
+  }
+
   fmpz_clear(size_fmpz);
 }
 
 /** @brief See header for a description
  */
 void CipherText::read(const string& inFileName, const bool binary) {
+  if (isMappedFile(inFileName)) {
+    readMapped(inFileName);
+    return;
+  }
+
   FILE* stream;
 
   stream = fopen(inFileName.c_str(), binary ? "rb" : "r");
@@ -254,12 +357,29 @@ void CipherText::read(const string& inFileName, const bool binary) {
 void CipherText::write(FILE* const stream, const bool binary) const {
   fmpz_t size;
   fmpz_init_set_ui(size, this->size());
-  
+
+  /* negative size means the last polynomial is stored as a seed */
+  if (seeded) {
+    fmpz_neg(size, size);
+  }
+
   PolyRing::write_fmpz(stream, size, binary);
-  
-  for (unsigned int i = 0; i < this->size(); i++) {
+
+  unsigned int nrPolys = seeded ? this->size() - 1 : this->size();
+  for (unsigned int i = 0; i < nrPolys; i++) {
     dataPoly[i]->write(stream, binary);
-  }  
+  }
+
+  if (seeded) {
+    fmpz_t tmp;
+    fmpz_init_set(tmp, seedModulus);
+    PolyRing::write_fmpz(stream, tmp, binary);
+
+    seed_to_fmpz(tmp, seed);
+    PolyRing::write_fmpz(stream, tmp, binary);
+
+    fmpz_clear(tmp);
+  }
 
   fmpz_clear(size);
 }
@@ -274,10 +394,151 @@ void CipherText::write(const string& outFileName, const bool binary) const {
   fclose(stream);
 }
 
+/* Memory-mappable ciphertext file header */
+static const char MAPPED_MAGIC[8] = {'C', 'I', 'N', 'G', 'M', 'A', 'P', '1'};
+
+struct MappedHeader {
+  char magic[8];
+  uint32_t nrPolys;
+  uint32_t polyLen;       // number of coefficients per polynomial
+  uint32_t limbsPerCoeff;
+  uint32_t pageSize;
+  uint64_t dataOffset;    // offset of first polynomial, page aligned
+  uint64_t polyStride;    // bytes per polynomial, page aligned
+};
+
+static uint64_t align_up(const uint64_t val, const uint64_t align) {
+  return (val + align - 1) / align * align;
+}
+
+/** @brief See header for a description
+ */
+bool CipherText::isMappedFile(const string& fileName) {
+  FILE* stream = fopen(fileName.c_str(), "rb");
+  if (stream == NULL) return false;
+
+  char magic[sizeof(MAPPED_MAGIC)];
+  bool isMapped = fread(magic, 1, sizeof(magic), stream) == sizeof(magic) and
+                  memcmp(magic, MAPPED_MAGIC, sizeof(magic)) == 0;
+  fclose(stream);
+
+  return isMapped;
+}
+
+/** @brief See header for a description
+ */
+void CipherText::readMapped(const string& inFileName) {
+  int fd = open(inFileName.c_str(), O_RDONLY);
+  if (fd == -1) {
+    cerr << "ERROR: Ciphertext::readMapped cannot open file '" << inFileName << "'" << endl;
+    exit(-1);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == -1 or (size_t)st.st_size < sizeof(MappedHeader)) {
+    cerr << "ERROR: Ciphertext::readMapped invalid file '" << inFileName << "'" << endl;
+    exit(-1);
+  }
+
+  void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    cerr << "ERROR: Ciphertext::readMapped cannot map file '" << inFileName << "'" << endl;
+    exit(-1);
+  }
+  madvise(addr, st.st_size, MADV_SEQUENTIAL);
+
+  const char* base = (const char*)addr;
+  const MappedHeader* hdr = (const MappedHeader*)base;
+
+  if (memcmp(hdr->magic, MAPPED_MAGIC, sizeof(MAPPED_MAGIC)) != 0 or
+      hdr->limbsPerCoeff == 0 or
+      hdr->polyStride < (uint64_t)hdr->polyLen * hdr->limbsPerCoeff * sizeof(mp_limb_t) or
+      hdr->dataOffset + hdr->nrPolys * hdr->polyStride > (uint64_t)st.st_size) {
+    cerr << "ERROR: Ciphertext::readMapped invalid file '" << inFileName << "'" << endl;
+    exit(-1);
+  }
+
+  const unsigned int coeffBitCnt = hdr->limbsPerCoeff * FLINT_BITS;
+
+  fmpz_t coeff;
+  fmpz_init(coeff);
+
+  this->resize(hdr->nrPolys);
+  for (unsigned int i = 0; i < hdr->nrPolys; ++i) {
+    const mp_limb_t* limbs = (const mp_limb_t*)(base + hdr->dataOffset + i * hdr->polyStride);
+
+    *dataPoly[i] = PolyRing();
+    for (unsigned int j = 0; j < hdr->polyLen; ++j) {
+      fmpz_bit_unpack_unsigned(coeff, limbs + j * hdr->limbsPerCoeff, 0, coeffBitCnt);
+      dataPoly[i]->setCoeff(j, coeff);
+    }
+  }
+
+  fmpz_clear(coeff);
+  munmap(addr, st.st_size);
+}
+
+/** @brief See header for a description
+ */
+void CipherText::writeMapped(const string& outFileName) const {
+  /* find polynomial length and coefficients size */
+  unsigned int polyLen = 0;
+  unsigned int coeffBitCnt = 1;
+  for (unsigned int i = 0; i < size(); ++i) {
+    const PolyRing& poly = *dataPoly[i];
+    if (poly.length() > polyLen) polyLen = poly.length();
+
+    for (unsigned int j = 0; j < poly.length(); ++j) {
+      const fmpz* coeff = poly.getCoeff(j);
+      if (fmpz_sgn(coeff) < 0) {
+        cerr << "ERROR: Ciphertext::writeMapped negative coefficients are not supported" << endl;
+        exit(-1);
+      }
+      if (fmpz_bits(coeff) > coeffBitCnt) coeffBitCnt = fmpz_bits(coeff);
+    }
+  }
+
+  MappedHeader hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, MAPPED_MAGIC, sizeof(MAPPED_MAGIC));
+  hdr.nrPolys = size();
+  hdr.polyLen = polyLen;
+  hdr.limbsPerCoeff = (coeffBitCnt + FLINT_BITS - 1) / FLINT_BITS;
+  hdr.pageSize = sysconf(_SC_PAGESIZE);
+  hdr.dataOffset = align_up(sizeof(hdr), hdr.pageSize);
+  hdr.polyStride = align_up((uint64_t)polyLen * hdr.limbsPerCoeff * sizeof(mp_limb_t), hdr.pageSize);
+
+  FILE* stream = fopen(outFileName.c_str(), "wb");
+  if (stream == NULL) {
+    cerr << "ERROR: Ciphertext::writeMapped cannot open file '" << outFileName << "'" << endl;
+    exit(-1);
+  }
+
+  vector<char> page(hdr.dataOffset, 0);
+  memcpy(page.data(), &hdr, sizeof(hdr));
+  fwrite(page.data(), 1, page.size(), stream);
+
+  vector<mp_limb_t> limbs(hdr.polyStride / sizeof(mp_limb_t));
+  for (unsigned int i = 0; i < size(); ++i) {
+    const PolyRing& poly = *dataPoly[i];
+
+    fill(limbs.begin(), limbs.end(), 0);
+    for (unsigned int j = 0; j < poly.length(); ++j) {
+      fmpz_bit_pack(limbs.data() + j * hdr.limbsPerCoeff, 0,
+                    hdr.limbsPerCoeff * FLINT_BITS, poly.getCoeff(j), 0, 0);
+    }
+    fwrite(limbs.data(), sizeof(mp_limb_t), limbs.size(), stream);
+  }
+
+  fclose(stream);
+}
 
 void CipherText::resize(const int newSize) {
   assert(polysAllocated);
 
+  clearSeed();
+
   int prevSize = size();
 
   if (newSize < prevSize) {
@@ -59,6 +59,47 @@ CipherText EncDec::EncryptPoly(const PolyRing& plainTxt_p, const CipherText& pub
   return ct;
 }
 
+/** @brief See header for description
+ */
+CipherText EncDec::EncryptPolySym(const PolyRing& plainTxt_p, const PolyRing& secretKey, const bool seeded)
+{
+  PolyRing plainTxt = ScalePlainTextPoly(plainTxt_p);
+
+  fmpz_poly_t tmp;
+  fmpz_poly_init(tmp);
+
+  /* Sample a <- Rq and e <- \chi */
+  SeededUniformRng::Seed seed;
+  if (seeded) {
+    SeededUniformRng::generateSeed(seed);
+    RandPolynom::sampleUniform(tmp, FheParams::D, FheParams::Q, seed);
+  } else {
+    RandPolynom::sampleUniform(tmp, FheParams::D, FheParams::Q);
+  }
+  PolyRing a(tmp);
+  PolyRing::modulo(a, FheParams::Q);
+
+  RandPolynom::sampleNormal(tmp, FheParams::D, FheParams::SIGMA, FheParams::B);
+  PolyRing e(tmp);
+
+  fmpz_poly_clear(tmp);
+
+  /* Compute ct0 = -(a . sk + e) + Delta . m mod q */
+  PolyRing ct0(a);
+  PolyRing::multiply(ct0, secretKey);
+  PolyRing::add(ct0, e);
+  PolyRing::negate(ct0);
+  PolyRing::add(ct0, plainTxt);
+  PolyRing::modulo(ct0, FheParams::Q);
+
+  CipherText ct(ct0, a);
+  if (seeded) {
+    ct.setSeed(seed, FheParams::Q);
+  }
+
+  return ct;
+}
+
 /** @brief See header for description
  */
 CipherText EncDec::EncryptPoly(const PolyRing& plainTxt)
@@ -27,6 +27,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <thread>
 
 
 using namespace std;
@@ -42,12 +43,18 @@ void KeyGen::generateSecretKey() {
   fmpz_poly_clear(tmp);
 }
 
-void KeyGen::generatePublicKey() {
+void KeyGen::generatePublicKey(const unsigned int p_nrThreads) {
   fmpz_poly_t tmp;
   fmpz_poly_init(tmp);
   
   /* Sample a <- Rq and e <- \chi */
-  RandPolynom::sampleUniform(tmp, FheParams::D, FheParams::Q);
+  SeededUniformRng::Seed seed;
+  if (seededKeys) {
+    SeededUniformRng::generateSeed(seed);
+    RandPolynom::sampleUniform(tmp, FheParams::D, FheParams::Q, seed);
+  } else {
+    RandPolynom::sampleUniform(tmp, FheParams::D, FheParams::Q, p_nrThreads);
+  }
   PolyRing *a = new PolyRing(tmp);
 
   //RandPolynom::sampleNormal(tmp, FheParams::D, FheParams::SIGMA, FheParams::B);
@@ -71,11 +78,14 @@ void KeyGen::generatePublicKey() {
 
   /* Store key */
   keysAll.PublicKey = new CipherText(ct1, a);
+  if (seededKeys) {
+    keysAll.PublicKey->setSeed(seed, FheParams::Q);
+  }
 
   fmpz_poly_clear(tmp);
 }
 
-void KeyGen::generateEvalKey() {
+void KeyGen::generateEvalKey(const unsigned int p_nrThreads) {
   fmpz_poly_t tmp;
   fmpz_poly_init(tmp);
 
@@ -83,37 +93,116 @@ void KeyGen::generateEvalKey() {
 
   /* Re-linearization version 2 evaluation key */  
   /* Sample a <- Rpq and e <- \chi */
-  RandPolynom::sampleUniform(tmp, FheParams::D, FheParams::PQ);
+  SeededUniformRng::Seed seed;
+  if (seededKeys) {
+    SeededUniformRng::generateSeed(seed);
+    RandPolynom::sampleUniform(tmp, FheParams::D, FheParams::PQ, seed);
+  } else {
+    RandPolynom::sampleUniform(tmp, FheParams::D, FheParams::PQ, p_nrThreads);
+  }
   PolyRing *a = new PolyRing(tmp);
   
   RandPolynom::sampleNormal(tmp, FheParams::D, FheParams::SIGMA_K, FheParams::B_K);
   PolyRing e(tmp);
 
+  /* Compute p . sk^2, concurrently with a . sk if possible */
+  PolyRing sk_copy(*(keysAll.SecretKey));
+  auto sk_square = [&sk_copy]() {
+    PolyRing::square(sk_copy);
+    PolyRing::multiply(sk_copy, FheParams::P);
+  };
+
+  thread sk_square_th;
+  if (p_nrThreads > 1) {
+    sk_square_th = thread(sk_square);
+  } else {
+    sk_square();
+  }
+
   /* Compute ct1 = -(a . sk + e) */
   PolyRing *ct1 = new PolyRing(*a);
   PolyRing::multiply(*ct1, *(keysAll.SecretKey));
   PolyRing::add(*ct1, e);
   PolyRing::negate(*ct1);
 
+  if (sk_square_th.joinable()) {
+    sk_square_th.join();
+  }
+
   /* Compute ct1 += p . sk^2 mod p.q */
-  PolyRing sk_copy(*(keysAll.SecretKey));
-  PolyRing::square(sk_copy);
-  PolyRing::multiply(sk_copy, FheParams::P);
   PolyRing::add(*ct1, sk_copy);  
   PolyRing::modulo(*ct1, FheParams::PQ);
   
   /* Store key */
   keysAll.EvalKey = new CipherText(ct1, a);
+  if (seededKeys) {
+    keysAll.EvalKey->setSeed(seed, FheParams::PQ);
+  }
 
   fmpz_poly_clear(tmp);
 }
 
 void KeyGen::generateKeys() {
   generateSecretKey();
-  generatePublicKey();
-  generateEvalKey();
+
+  /* Public and evaluation keys depend only on the secret key. Only the
+   * evaluation key uses the (non thread-safe) normal distribution sampler. */
+  if (nrThreads > 1) {
+    unsigned int pkThreads = nrThreads / 2;
+    thread pk_th(&KeyGen::generatePublicKey, this, pkThreads);
+    generateEvalKey(nrThreads - pkThreads);
+    pk_th.join();
+  } else {
+    generatePublicKey();
+    generateEvalKey();
+  }
+}
+
+void KeyGen::generateKeys(const string& fileNamePrefix, const bool binary,
+                          const bool mapped) {
+  generateSecretKey();
+
+  thread sk_writer([&]() {
+    FILE* stream = fopen((fileNamePrefix + ".sk").c_str(), binary ? "wb" : "w");
+    keysAll.writeSecretKey(stream, binary);
+    fclose(stream);
+  });
+
+  auto writeKey = [&](const CipherText* key, const string& fileName) {
+    if (mapped) {
+      key->writeMapped(fileName);
+    } else {
+      key->write(fileName, binary);
+    }
+  };
+
+  auto pk_task = [&](const unsigned int p_nrThreads) {
+    generatePublicKey(p_nrThreads);
+    writeKey(keysAll.PublicKey, fileNamePrefix + ".pk");
+  };
+
+  auto evk_task = [&](const unsigned int p_nrThreads) {
+    generateEvalKey(p_nrThreads);
+    writeKey(keysAll.EvalKey, fileNamePrefix + ".evk");
+  };
+
+  if (nrThreads > 1) {
+    unsigned int pkThreads = nrThreads / 2;
+    thread pk_th(pk_task, pkThreads);
+    evk_task(nrThreads - pkThreads);
+    pk_th.join();
+  } else {
+    pk_task(1);
+    evk_task(1);
+  }
+
+  sk_writer.join();
 }
 
 void KeyGen::writeKeys(const string& fileNamePrefix, const bool binary) {
   keysAll.writeKeys(fileNamePrefix, binary);
 }
+
+void KeyGen::writeKeysMapped(const string& fileNamePrefix) {
+  keysAll.writeKeysMapped(fileNamePrefix);
+}
@@ -85,4 +85,14 @@ void KeysAll::writeKeys(const string& fileNamePrefix, const bool binary) {
   KeysShare::writeKeys(fileNamePrefix, binary);
 }
 
+/** @brief See header for a description
+ */
+void KeysAll::writeKeysMapped(const string& fileNamePrefix) {
+  FILE* stream;
 
+  stream = fopen((fileNamePrefix + ".sk").c_str(), "wb");
+  writeSecretKey(stream, true);
+  fclose(stream);
+
+  KeysShare::writeKeysMapped(fileNamePrefix);
+}
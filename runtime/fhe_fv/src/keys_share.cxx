@@ -48,6 +48,16 @@ void KeysShare::readPublicKey(FILE* const stream, const bool binary) {
 /** @brief See header for a description
  */
 void KeysShare::readPublicKey(const string& fileName, const bool binary) {
+  if (CipherText::isMappedFile(fileName)) {
+    if (PublicKey != NULL) {
+      delete PublicKey;
+    }
+
+    PublicKey = new CipherText();
+    PublicKey->readMapped(fileName);
+    return;
+  }
+
   FILE* stream;
 
   stream = fopen(fileName.c_str(), binary ? "rb" : "r");
@@ -65,16 +75,26 @@ void KeysShare::readPublicKey(const string& fileName, const bool binary) {
  */
 void KeysShare::readEvalKey(FILE* const stream, const bool binary) {
   if (EvalKey != NULL) {
-    delete PublicKey;
+    delete EvalKey;
   }
   
   EvalKey = new CipherText();
-  EvalKey->read(stream);
+  EvalKey->read(stream, binary);
 }
 
 /** @brief See header for a description
  */
 void KeysShare::readEvalKey(const string& fileName, const bool binary) {
+  if (CipherText::isMappedFile(fileName)) {
+    if (EvalKey != NULL) {
+      delete EvalKey;
+    }
+
+    EvalKey = new CipherText();
+    EvalKey->readMapped(fileName);
+    return;
+  }
+
   FILE* stream;
 
   stream = fopen(fileName.c_str(), binary ? "rb" : "r");
@@ -125,3 +145,14 @@ void KeysShare::writeKeys(const string& fileNamePrefix, const bool binary) {
   fclose(stream);
 }
 
+/** @brief See header for a description
+ */
+void KeysShare::writeKeysMapped(const string& fileNamePrefix) {
+  if (PublicKey != NULL) {
+    PublicKey->writeMapped(fileNamePrefix + ".pk");
+  }
+
+  if (EvalKey != NULL) {
+    EvalKey->writeMapped(fileNamePrefix + ".evk");
+  }
+}
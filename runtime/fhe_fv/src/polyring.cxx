@@ -221,6 +221,26 @@ void PolyRing::square(PolyRing& prElem) {
   reduce(prElem);
 }
 
+/** @brief See header for a description
+ */
+void PolyRing::multiply_monomial(PolyRing& prElem, const unsigned int k) {
+  unsigned int shift = k;
+
+  if (FheParams::IsPowerOfTwoCyclotomic) {
+    /* X^k = (-1)^(k/D) . X^(k mod D) */
+    shift = k % (2 * FheParams::D);
+    if (shift >= FheParams::D) {
+      negate(prElem);
+      shift -= FheParams::D;
+    }
+  }
+
+  fmpz_poly_shift_left(prElem.polyData, prElem.polyData, shift);
+
+  /* Reduce by polynomial ring modulo */
+  reduce(prElem);
+}
+
 /** @brief See header for a description
  */
 PolyRing& PolyRing::operator=(const PolyRing& prElem) {
@@ -22,6 +22,11 @@
 #include "uniform.hxx"
 #include "normal.hxx"
 
+#include <thread>
+#include <vector>
+
+using namespace std;
+
 /** @brief See header for description.
  */
 void RandPolynom::populateBinaryPolyRing(fmpz_poly_t poly, fmpz_t num) {
@@ -56,24 +61,58 @@ void RandPolynom::sampleUniformBinary(fmpz_poly_t poly, unsigned int len, unsign
 
 /** @brief See header for description.
  */
-void RandPolynom::sampleUniform(fmpz_poly_t poly, unsigned int len, unsigned int coeffBitCnt) {
+void RandPolynom::sampleUniform(fmpz_poly_t poly, unsigned int len,
+                                unsigned int coeffBitCnt,
+                                unsigned int nrThreads) {
+  fmpz_poly_zero(poly);
+  fmpz_poly_fit_length(poly, len);
+
+  /* each thread samples a contiguous range of coefficients */
+  if (nrThreads < 1) nrThreads = 1;
+  unsigned int chunk = (len + nrThreads - 1) / nrThreads;
+
+  vector<thread> ths;
+  for (unsigned int start = 0; start < len; start += chunk) {
+    unsigned int cnt = (len - start < chunk) ? len - start : chunk;
+    ths.push_back(thread(
+      [=]() { UniformRng::sampleVec(poly->coeffs + start, cnt, coeffBitCnt); }));
+  }
+  for (thread& th : ths) {
+    th.join();
+  }
+
+  _fmpz_poly_set_length(poly, len);
+  _fmpz_poly_normalise(poly);
+}
+
+/** @brief See header for description.
+ */
+void RandPolynom::sampleUniform(fmpz_poly_t poly, unsigned int len, fmpz_t q,
+                                unsigned int nrThreads) {
+  sampleUniform(poly, len, fmpz_sizeinbase(q, 2), nrThreads);
+}
+
+/** @brief See header for description.
+ */
+void RandPolynom::sampleUniform(fmpz_poly_t poly, unsigned int len,
+                                const fmpz_t q,
+                                const SeededUniformRng::Seed& seed) {
+  SeededUniformRng rng(seed);
+  unsigned int coeffBitCnt = fmpz_sizeinbase(q, 2);
+
   fmpz_t d;
   fmpz_init(d);
-  
+
+  fmpz_poly_zero(poly);
   for (unsigned int i = 0; i < len; i++){
-    UniformRng::sample(d, coeffBitCnt);
+    rng.sample(d, coeffBitCnt);
+    fmpz_mod(d, d, q);
     fmpz_poly_set_coeff_fmpz(poly, i, d);
   }
 
   fmpz_clear(d);
 }
 
-/** @brief See header for description.
- */
-void RandPolynom::sampleUniform(fmpz_poly_t poly, unsigned int len, fmpz_t q) {
-  sampleUniform(poly, len, fmpz_sizeinbase(q, 2));
-}
-
 /** @brief See header for description.
  */
 void RandPolynom::sampleNormal(fmpz_poly_t poly, unsigned int len, fmpz_t sigma, fmpz_t B) {
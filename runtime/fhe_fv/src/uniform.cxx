@@ -26,6 +26,9 @@
 #include <math.h>
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
 
 using namespace std;
 
@@ -73,6 +76,38 @@ void UniformRng::sample(fmpz_t num, unsigned int bitCnt) {
   fmpz_bit_unpack_unsigned(num, (mp_limb_t*)buff, 0, bitCnt);
 }
 
+/** @brief See header for description.
+ */
+void UniformRng::sampleVec(fmpz* nums, unsigned int cnt, unsigned int bitCnt) {
+  int randDev = open("/dev/urandom", O_RDONLY);
+  if (randDev == -1) {
+    cerr << "File: " << __FILE__ << " line: " << __LINE__
+      << " - cannot open random generator \"/dev/urandom\"" << endl;
+    exit(-1);
+  }
+
+  const unsigned int byteCnt = bits2Bytes(bitCnt);
+  const unsigned int blockCnt = 4096 / byteCnt + 1;
+
+  std::vector<unsigned char> buff(blockCnt * byteCnt);
+  std::vector<mp_limb_t> limbs((bitCnt + FLINT_BITS - 1) / FLINT_BITS + 1);
+
+  for (unsigned int i = 0; i < cnt; i += blockCnt) {
+    unsigned int n = (cnt - i < blockCnt) ? cnt - i : blockCnt;
+
+    unsigned int r = read(randDev, buff.data(), n * byteCnt);
+    assert(r == n * byteCnt);
+
+    for (unsigned int k = 0; k < n; ++k) {
+      fill(limbs.begin(), limbs.end(), 0);
+      memcpy(limbs.data(), buff.data() + k * byteCnt, byteCnt);
+      fmpz_bit_unpack_unsigned(nums + i + k, limbs.data(), 0, bitCnt);
+    }
+  }
+
+  close(randDev);
+}
+
 /** @brief See header for description.
  */
 void UniformRng::sample(fmpz_t num_p,
@@ -112,3 +147,111 @@ void UniformRng::sample(fmpz_t num_p,
   }  
 }
 
+/** @brief See header for description.
+ */
+void SeededUniformRng::generateSeed(Seed& seed) {
+  int randDev = open("/dev/urandom", O_RDONLY);
+  if (randDev == -1) {
+    cerr << "File: " << __FILE__ << " line: " << __LINE__
+      << " - cannot open random generator \"/dev/urandom\"" << endl;
+    exit(-1);
+  }
+
+  unsigned int r = read(randDev, seed.data(), seed.size());
+  assert(r == seed.size());
+  close(randDev);
+}
+
+static inline uint32_t load32_le(const unsigned char* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+    ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint32_t rotl32(const uint32_t v, const int n) {
+  return (v << n) | (v >> (32 - n));
+}
+
+#define QUARTER_ROUND(a, b, c, d) \
+  a += b; d ^= a; d = rotl32(d, 16); \
+  c += d; b ^= c; b = rotl32(b, 12); \
+  a += b; d ^= a; d = rotl32(d,  8); \
+  c += d; b ^= c; b = rotl32(b,  7);
+
+/** @brief See header for description.
+ */
+SeededUniformRng::SeededUniformRng(const Seed& seed) {
+  /* "expand 32-byte k" */
+  state[0] = 0x61707865;
+  state[1] = 0x3320646e;
+  state[2] = 0x79622d32;
+  state[3] = 0x6b206574;
+  for (unsigned int i = 0; i < 8; ++i) {
+    state[4 + i] = load32_le(seed.data() + 4 * i);
+  }
+  /* block counter and zero nonce */
+  for (unsigned int i = 12; i < 16; ++i) {
+    state[i] = 0;
+  }
+
+  blockPos = sizeof(block);
+}
+
+/** @brief See header for description.
+ */
+void SeededUniformRng::nextBlock() {
+  uint32_t x[16];
+  memcpy(x, state, sizeof(x));
+
+  for (unsigned int i = 0; i < 10; ++i) {
+    QUARTER_ROUND(x[0], x[4], x[ 8], x[12]);
+    QUARTER_ROUND(x[1], x[5], x[ 9], x[13]);
+    QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+    QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+    QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+    QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+    QUARTER_ROUND(x[2], x[7], x[ 8], x[13]);
+    QUARTER_ROUND(x[3], x[4], x[ 9], x[14]);
+  }
+
+  for (unsigned int i = 0; i < 16; ++i) {
+    uint32_t v = x[i] + state[i];
+    block[4 * i + 0] = v & 0xff;
+    block[4 * i + 1] = (v >> 8) & 0xff;
+    block[4 * i + 2] = (v >> 16) & 0xff;
+    block[4 * i + 3] = (v >> 24) & 0xff;
+  }
+
+  /* 64-bit block counter */
+  if (++state[12] == 0) ++state[13];
+
+  blockPos = 0;
+}
+
+#undef QUARTER_ROUND
+
+/** @brief See header for description.
+ */
+void SeededUniformRng::nextBytes(unsigned char* buff, unsigned int len) {
+  while (len > 0) {
+    if (blockPos == sizeof(block)) nextBlock();
+
+    unsigned int n = sizeof(block) - blockPos;
+    if (n > len) n = len;
+
+    memcpy(buff, block + blockPos, n);
+    blockPos += n;
+    buff += n;
+    len -= n;
+  }
+}
+
+/** @brief See header for description.
+ */
+void SeededUniformRng::sample(fmpz_t num, unsigned int bitCnt) {
+  unsigned int byteCnt = bits2Bytes(bitCnt);
+  std::vector<mp_limb_t> buff((bitCnt + FLINT_BITS - 1) / FLINT_BITS + 1, 0);
+
+  nextBytes((unsigned char*)buff.data(), byteCnt);
+
+  fmpz_bit_unpack_unsigned(num, buff.data(), 0, bitCnt);
+}
@@ -76,7 +76,12 @@ protected:
   const Alloc *alloc;
 
 #ifdef USE_OBJ_POOL
+#ifdef TFHE_THREADING
+  /* handles can be created and released from several threads */
+  using ObjMan = obj_man::Pool<Alloc, true>;
+#else
   using ObjMan = obj_man::Pool<Alloc>;
+#endif
 #else
   using ObjMan = obj_man::Basic<Alloc>;
 #endif
@@ -84,6 +89,62 @@ protected:
   ObjMan *mm;
 };
 
+#ifdef TFHE_THREADING
+/**
+ * @brief      Bit executor for TFHE library which evaluates gates
+ *             asynchronously on a thread pool.
+ * @details    Gate operations return immediately a handle to the (not yet
+ *             computed) result. Gates are queued into a dependency graph and
+ *             are evaluated by worker threads as soon as their inputs are
+ *             available. Methods @c decrypt and @c write wait for their input
+ *             to be computed.
+ */
+class TfheParallelBitExec : public TfheBitExec {
+public:
+  /**
+   * @brief      Constructs the executor
+   *
+   * @param[in]  p_filename    key file name
+   * @param[in]  p_keytype     key type
+   * @param[in]  p_nr_threads  number of worker threads, hardware concurrency
+   *                           is used if 0
+   */
+  TfheParallelBitExec(const std::string &p_filename, const KeyType p_keytype,
+                      const unsigned p_nr_threads = 0);
+  ~TfheParallelBitExec();
+
+  /**
+   * @brief      Waits until all queued gates are evaluated
+   */
+  void sync();
+
+  /* clang-format off */
+  bit_plain_t decrypt     (const ObjHandle& in1)                          override;
+  void        write       (const ObjHandle& in1, const std::string& name) override;
+
+  ObjHandle   op_not      (const ObjHandle& in1)                          override;
+  ObjHandle   op_and      (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_xor      (const ObjHandle& in1, const ObjHandle& in2)    override;
+
+  ObjHandle   op_nand     (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_andyn    (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_andny    (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_or       (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_nor      (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_oryn     (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_orny     (const ObjHandle& in1, const ObjHandle& in2)    override;
+  ObjHandle   op_xnor     (const ObjHandle& in1, const ObjHandle& in2)    override;
+
+  ObjHandle   op_mux      (const ObjHandle& cond,
+                            const ObjHandle& in1, const ObjHandle& in2)   override;
+  /* clang-format on */
+
+protected:
+  class Scheduler;
+  Scheduler *scheduler;
+};
+#endif
+
 } // namespace cingulata
 
 #endif
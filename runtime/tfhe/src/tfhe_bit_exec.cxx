@@ -28,6 +28,16 @@
 #include <fstream>
 #include <iostream>
 
+#ifdef TFHE_THREADING
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#endif
+
 using namespace std;
 using namespace cingulata;
 
@@ -186,3 +196,193 @@ ObjHandle TfheBitExec::op_mux(const ObjHandle &cond, const ObjHandle &in1,
            in1.get<LweSample>(), context->pk());
   return hdl;
 }
+
+#ifdef TFHE_THREADING
+
+/**
+ * @brief      Dependency graph of pending gates and worker threads evaluating
+ *             them
+ * @details    A gate is pending from its submission until its evaluation
+ *             ends. Pending gates are indexed by their output object. Each
+ *             gate keeps handles to its inputs and output, thus these objects
+ *             cannot be recycled before the gate is evaluated.
+ */
+class TfheParallelBitExec::Scheduler {
+public:
+  Scheduler(const unsigned p_nr_threads) {
+    for (unsigned i = 0; i < p_nr_threads; ++i)
+      m_threads.emplace_back(&Scheduler::worker, this);
+  }
+
+  ~Scheduler() {
+    wait_all();
+    {
+      lock_guard<mutex> lock(m_mtx);
+      m_stop = true;
+    }
+    m_cv_ready.notify_all();
+    for (thread &th : m_threads)
+      th.join();
+  }
+
+  /**
+   * @brief      Queues a gate evaluation
+   *
+   * @param[in]  out   gate output object
+   * @param[in]  inps  gate input objects
+   * @param[in]  fnc   gate evaluation function
+   */
+  void submit(const ObjHandle &out, vector<ObjHandle> &&inps,
+              function<void()> &&fnc) {
+    Task *task = new Task{move(fnc), out, move(inps), 0, {}};
+
+    lock_guard<mutex> lock(m_mtx);
+    for (const ObjHandle &inp : task->inps) {
+      auto it = m_pending.find(inp.get<void>());
+      if (it != m_pending.end()) {
+        it->second->dependents.push_back(task);
+        task->nr_deps++;
+      }
+    }
+    m_pending[out.get<void>()] = task;
+
+    if (task->nr_deps == 0) {
+      m_ready.push_back(task);
+      m_cv_ready.notify_one();
+    }
+  }
+
+  /**
+   * @brief      Waits until object @c obj is computed
+   */
+  void wait(const void *obj) {
+    unique_lock<mutex> lock(m_mtx);
+    m_cv_done.wait(lock, [&] { return m_pending.count(obj) == 0; });
+  }
+
+  /**
+   * @brief      Waits until all pending gates are evaluated
+   */
+  void wait_all() {
+    unique_lock<mutex> lock(m_mtx);
+    m_cv_done.wait(lock, [&] { return m_pending.empty(); });
+  }
+
+private:
+  struct Task {
+    function<void()> fnc;
+    ObjHandle out;
+    vector<ObjHandle> inps;
+    unsigned nr_deps;
+    vector<Task *> dependents;
+  };
+
+  void worker() {
+    unique_lock<mutex> lock(m_mtx);
+    while (true) {
+      m_cv_ready.wait(lock, [&] { return m_stop or not m_ready.empty(); });
+      if (m_ready.empty())
+        return;
+
+      Task *task = m_ready.front();
+      m_ready.pop_front();
+
+      lock.unlock();
+      task->fnc();
+      lock.lock();
+
+      m_pending.erase(task->out.get<void>());
+      for (Task *dep : task->dependents) {
+        if (--dep->nr_deps == 0) {
+          m_ready.push_back(dep);
+          m_cv_ready.notify_one();
+        }
+      }
+      m_cv_done.notify_all();
+
+      /* release handles outside of the critical section */
+      lock.unlock();
+      delete task;
+      lock.lock();
+    }
+  }
+
+  mutex m_mtx;
+  condition_variable m_cv_ready;
+  condition_variable m_cv_done;
+  unordered_map<const void *, Task *> m_pending;
+  deque<Task *> m_ready;
+  vector<thread> m_threads;
+  bool m_stop = false;
+};
+
+TfheParallelBitExec::TfheParallelBitExec(const string &p_filename,
+                                         const KeyType p_keytype,
+                                         const unsigned p_nr_threads)
+    : TfheBitExec(p_filename, p_keytype),
+      scheduler(new Scheduler(p_nr_threads > 0
+                                  ? p_nr_threads
+                                  : max(1u, thread::hardware_concurrency()))) {}
+
+TfheParallelBitExec::~TfheParallelBitExec() { delete scheduler; }
+
+void TfheParallelBitExec::sync() { scheduler->wait_all(); }
+
+bit_plain_t TfheParallelBitExec::decrypt(const ObjHandle &in) {
+  scheduler->wait(in.get<void>());
+  return TfheBitExec::decrypt(in);
+}
+
+void TfheParallelBitExec::write(const ObjHandle &in, const string &name) {
+  scheduler->wait(in.get<void>());
+  TfheBitExec::write(in, name);
+}
+
+ObjHandle TfheParallelBitExec::op_not(const ObjHandle &in) {
+  ObjHandleT<LweSample> hdl = mm->new_handle();
+  LweSample *res = hdl.get();
+  const LweSample *a = in.get<LweSample>();
+  const TFheGateBootstrappingCloudKeySet *pk = context->pk();
+  scheduler->submit(hdl, {in}, [=] { bootsNOT(res, a, pk); });
+  return hdl;
+}
+
+#define TFHE_PAR_EXEC_OPER(OPER, TFHE_FNC)                                     \
+  ObjHandle TfheParallelBitExec::OPER(const ObjHandle &in1,                    \
+                                      const ObjHandle &in2) {                  \
+    ObjHandleT<LweSample> hdl = mm->new_handle();                              \
+    LweSample *res = hdl.get();                                                \
+    const LweSample *a = in1.get<LweSample>();                                 \
+    const LweSample *b = in2.get<LweSample>();                                 \
+    const TFheGateBootstrappingCloudKeySet *pk = context->pk();                \
+    scheduler->submit(hdl, {in1, in2}, [=] { TFHE_FNC(res, a, b, pk); });      \
+    return hdl;                                                                \
+  }
+
+TFHE_PAR_EXEC_OPER(op_and, bootsAND);
+TFHE_PAR_EXEC_OPER(op_xor, bootsXOR);
+TFHE_PAR_EXEC_OPER(op_nand, bootsNAND);
+TFHE_PAR_EXEC_OPER(op_andyn, bootsANDYN);
+TFHE_PAR_EXEC_OPER(op_andny, bootsANDNY);
+TFHE_PAR_EXEC_OPER(op_or, bootsOR);
+TFHE_PAR_EXEC_OPER(op_nor, bootsNOR);
+TFHE_PAR_EXEC_OPER(op_oryn, bootsORYN);
+TFHE_PAR_EXEC_OPER(op_orny, bootsORNY);
+TFHE_PAR_EXEC_OPER(op_xnor, bootsXNOR);
+
+ObjHandle TfheParallelBitExec::op_mux(const ObjHandle &cond,
+                                      const ObjHandle &in1,
+                                      const ObjHandle &in2) {
+  ObjHandleT<LweSample> hdl = mm->new_handle();
+  LweSample *res = hdl.get();
+  const LweSample *c = cond.get<LweSample>();
+  const LweSample *a = in1.get<LweSample>();
+  const LweSample *b = in2.get<LweSample>();
+  const TFheGateBootstrappingCloudKeySet *pk = context->pk();
+  /* mux gate in tfhe is cond ? <first input> : <second input> */
+  scheduler->submit(hdl, {cond, in1, in2},
+                    [=] { bootsMUX(res, c, b, a, pk); });
+  return hdl;
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Cingulata team (formerly Armadillo team)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+/**
+ * Checks that the parallel TFHE bit executor computes the same results as the
+ * sequential one. Requires a TFHE secret key in file "tfhe.sk" and a build
+ * with TFHE_THREADING enabled.
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+/* local includes */
+#include <ci_context.hxx>
+#include <ci_int.hxx>
+#include <int_op_gen/size.hxx>
+#include <tfhe_bit_exec.hxx>
+
+/* namespaces */
+using namespace std;
+using namespace cingulata;
+
+namespace {
+/**
+ * @brief      Evaluates @c a*b+(a^b) on encrypted 8-bit inputs with executor
+ *             @c exec and returns the decrypted result
+ */
+uint64_t compute(shared_ptr<IBitExec> exec, const unsigned a_val,
+                 const unsigned b_val) {
+  CiContext::set_config(exec, make_shared<IntOpGenSize>());
+
+  CiInt a{a_val, 8, false};
+  CiInt b{b_val, 8, false};
+  a.encrypt();
+  b.encrypt();
+
+  CiInt c = a * b + (a ^ b);
+  return c.decrypt().get_val();
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+#ifdef TFHE_THREADING
+  const unsigned nr_threads = argc > 1 ? atoi(argv[1]) : 4;
+
+  auto seq_exec = make_shared<TfheBitExec>("tfhe.sk", TfheBitExec::Secret);
+  auto par_exec = make_shared<TfheParallelBitExec>(
+      "tfhe.sk", TfheBitExec::Secret, nr_threads);
+
+  const unsigned vals[][2] = {{0, 0}, {5, 3}, {201, 77}, {255, 255}};
+
+  int ret = 0;
+  for (const auto &v : vals) {
+    const uint64_t exp = (v[0] * v[1] + (v[0] ^ v[1])) & 0xFF;
+    const uint64_t seq = compute(seq_exec, v[0], v[1]);
+    const uint64_t par = compute(par_exec, v[0], v[1]);
+
+    cout << v[0] << "*" << v[1] << "+(" << v[0] << "^" << v[1] << ") = " << par
+         << " (sequential " << seq << ", expected " << exp << ")" << endl;
+    if (seq != exp or par != exp)
+      ret = 1;
+  }
+
+  cout << (ret == 0 ? "PASSED" : "FAILED") << endl;
+  return ret;
+#else
+  cerr << "TFHE bit executor built without TFHE_THREADING, skipping" << endl;
+  return 0;
+#endif
+}
@@ -44,10 +44,7 @@ int main() {
     a[i].read("a_" + to_string(i));
 
 
-  CiInt r = a[0];
-  for (int i = 1; i < N; ++i) {
-    r = select(r > a[i], a[i], r);
-  }
+  CiInt r = min(a);
 
   r.write("r");
 